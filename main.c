@@ -8,23 +8,49 @@
 #include <SDL_mixer.h>
 #include <SDL_ttf.h>
 
-// Return a random float in [0, 1].
-static float rand01(void)
-{
-    return (float)rand() / (float)RAND_MAX;
-}
+// Read-only file mapping for the glyph cache (map_file()).
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// SIMD kernel variants are compiled side by side and one set is picked at
+// startup by simd_init(). GCC and Clang need a target attribute on x86
+// variants above the build's baseline; MSVC takes the intrinsics as is.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE2
+#define TARGET_AVX2
+#endif
+#endif
 
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#endif
 
 
 // ---------------------------------------------------------
 // Constants
 // ---------------------------------------------------------
+#define FONT_FILE              "matrix.ttf"
 #define FONT_SIZE              14//11//13//22//26
 #define CHAR_SPACING           8//8//8//16//16
 #define glyph_START_Y          -25
 #define DEFAULT_SIMULATION_FPS 30
 #define ALPHABET_SIZE          62//36
-#define MAX_TRAIL_LENGTH       256
+#define MAX_TRAIL_LENGTH       256   // must be a power of two (ring buffer mask)
+#define TRAIL_MASK             (MAX_TRAIL_LENGTH - 1)
 
 // UI overlay
 #define UI_COLOR_HIT_WIDTH     220
@@ -51,15 +77,77 @@ int* mn = NULL;
 int  RANGE = 0;
 int* isActive = NULL;
 int* headGlyphIndex = NULL;
-int* freeIndexList = NULL;
-int  freeIndexCount = 0;
+int* HeadY = NULL;                  // y of the column's head cell
+
+// Dense set of column indices with O(1) add/remove (swap with last).
+typedef struct {
+    int* items;   // members, packed at [0, count)
+    int* pos;     // pos[col] = index into items, or -1 when absent
+    int  count;
+} ColumnSet;
+
+// Columns the simulation has to touch: streaming heads plus inactive
+// columns whose trail is still fading (its fade is driven by ColumnTravel).
+ColumnSet liveColumns = { 0 };
+
+// Columns without a streaming head; spawn() picks uniformly from these.
+ColumnSet freeColumns = { 0 };
 
 int   simulationFPS = DEFAULT_SIMULATION_FPS;
 float simulationStepMs = 0.0f;
 
+// Random stream state: see rand_stream().
+typedef struct {
+    Uint64 key;       // hash of (seed, column, tick, purpose)
+    Uint32 counter;   // draws taken so far
+} RandStream;
+
+// Stream purposes, so the phases of one tick never reuse each other's draws.
+enum {
+    RAND_INIT = 0,
+    RAND_SPAWN,
+    RAND_RETARGET,
+    RAND_CROSSING
+};
+#define RAND_COLUMN_GLOBAL  (-1)   // per-tick decisions not owned by a column
+
+Uint64 randSeed = 0;
+Uint32 simTick = 0;                // simulation steps taken so far
+
+// Worker pool for the per-column phases of simulate_step(). Workers claim
+// SIM_CHUNK_COLUMNS-sized slices of the live list from a shared cursor, so
+// columns with long trails do not stall one statically assigned range.
+#define SIM_MAX_WORKERS           15
+#define SIM_CHUNK_COLUMNS         64
+#define SIM_PARALLEL_MIN_COLUMNS  256   // below this the hand-off costs more than it saves
+
+typedef struct {
+    SDL_Thread*  threads[SIM_MAX_WORKERS];
+    int          count;            // worker threads (the stepping thread also works)
+    SDL_sem*     start;            // one post per worker per step
+    SDL_sem*     done;             // one post per worker when the cursor is drained
+    SDL_atomic_t cursor;           // next unclaimed index into cols
+    SDL_atomic_t quit;
+    const int*   cols;             // job: live list snapshot for this step
+    int          colCount;
+} SimWorkerPool;
+
+SimWorkerPool simPool = { 0 };
+int simThreadsRequested = -1;      // --threads; -1 = one per core not running the render or simulation thread
+
 float* speed = NULL;
 float* VerticalAccumulator = NULL;
 float* ColumnTravel = NULL;
+float* ColumnMovement = NULL;       // travel added this tick (speed kernel output)
+
+// All per-column arrays above and below are slices of one SIMD-aligned
+// block, one cache-line-padded slice per array (structure of arrays).
+#define COLUMN_ARRAY_COUNT    13
+#define COLUMN_STRIDE_ALIGN   16    // elements: 16 x 4 bytes = one 64-byte line
+
+void* columnArena = NULL;
+
+SDL_COMPILE_TIME_ASSERT(column_int_slices, sizeof(int) == sizeof(float));
 
 // ---------------------------------------------------------
 // Dynamic per-column speed modulation
@@ -92,7 +180,8 @@ float* SpeedRetargetTimer = NULL;  // Countdown (scaled by speed) until picking
 #define SPEED_GRAVITY               0.0f   // key
 
 
-float WaveHue = 0.0f;
+float WaveHue = 0.0f;   // simulation thread: advanced per step in WAVE mode
+#define WAVE_HUE_DEG_PER_SEC   6.0f
 
 float FadeDistance = 750.0f; //1500.0f
 
@@ -113,29 +202,166 @@ TTF_Font* font1 = NULL;
 // ---------------------------------------------------------
 // Glyph trail data structures
 // ---------------------------------------------------------
+// Packed to 12 bytes: x, w and h are the same for every glyph of a column
+// (mn[col], emptyTextureWidth, emptyTextureHeight), so only the row is kept
+// and the on-screen rect is rebuilt with glyph_rect() at draw time.
 typedef struct {
-    int glyphIndex;
-    float fadeTimer;     // spawn travel position
-    SDL_Rect rect;
-    bool isHead;
-
-    // Per-glyph hue for RAINBOW mode.
-    // Only meaningful when headColorMode==5 at spawn time.
-    float spawnHue;
+    float  fadeTimer;    // spawn travel position
+    Uint16 row;          // cell row: y = glyph_START_Y + row * emptyTextureHeight
+    Uint8  glyphIndex;
+
+    // Head colour resolved at spawn time (random hue in RAINBOW, the wave
+    // hue in WAVE, the mode's head colour otherwise). WAVE/RAINBOW draw
+    // the glyph from it; its base colour is half of it.
+    Uint8  headR;
+    Uint8  headG;
+    Uint8  headB;
 } StaticGlyph;
 
-StaticGlyph** fadingTrails = NULL;
-int* trailCounts = NULL;
+SDL_COMPILE_TIME_ASSERT(static_glyph_size, sizeof(StaticGlyph) == 12);
+
+// Each column's trail is a ring buffer. trailHead is the serial of the next
+// glyph to write, trailTail the serial of the oldest live glyph; slots are
+// serial & TRAIL_MASK and the live count is trailHead - trailTail.
+// Glyphs are spawned in increasing fadeTimer order, so faded glyphs always
+// form a prefix and are retired by advancing trailTail.
+// All rings share one allocation; column col starts at col * MAX_TRAIL_LENGTH.
+StaticGlyph* fadingTrails = NULL;
+Uint32* trailHead = NULL;
+Uint32* trailTail = NULL;
+
+// Set when the newest glyph of a column was spawned since the last
+// published snapshot and should be drawn as the bright head.
+bool* headPending = NULL;
+
+// ---------------------------------------------------------
+// Render snapshots (simulation thread -> render thread)
+// ---------------------------------------------------------
+// The simulation thread publishes the live part of every trail into a
+// snapshot after each batch of steps; the renderer only ever reads
+// snapshots. Three buffers are exchanged through one atomic, so neither
+// side waits: the simulation thread owns snapshotBack, the renderer owns
+// snapshotFront, and snapshotReady holds the latest published index plus
+// SNAPSHOT_FRESH.
+//
+// Snapshot glyphs mirror the trail rings, each ring stored twice in a row
+// so any live window is contiguous from (tail & TRAIL_MASK). Glyphs never
+// change after spawn, so a publish copies only the glyphs spawned since
+// that buffer was last filled (copiedHead), not every live glyph.
+#define SNAPSHOT_COUNT   3
+#define SNAPSHOT_FRESH   0x4
+
+typedef struct {
+    int   col;
+    int   first;      // index of the oldest glyph in RenderSnapshot::glyphs (count contiguous)
+    int   count;
+    float travel;     // ColumnTravel at publish time
+    float movement;   // travel added by the last step (for interpolation)
+    float headY;      // continuous head position: HeadY + VerticalAccumulator
+    Uint32 headSerial;  // trailHead at publish: the newest glyph is headSerial - 1
+    bool  head;       // newest glyph was spawned since the previous snapshot
+    bool  active;     // head is still streaming
+} SnapshotColumn;
+
+typedef struct {
+    Uint32          sequence;      // publish counter; 0 = never published
+    Uint64          time;          // performance counter the state belongs to
+    float           stepMs;        // step length it was simulated with
+    int             columnCount;
+    SnapshotColumn* columns;       // RANGE capacity, ascending col
+    StaticGlyph*    glyphs;        // column col: 2 * MAX_TRAIL_LENGTH from col * 2 * MAX_TRAIL_LENGTH
+    Uint32*         copiedHead;    // per column: glyphs below this serial are in glyphs[]
+} RenderSnapshot;
+
+RenderSnapshot snapshots[SNAPSHOT_COUNT] = { 0 };
+SDL_atomic_t snapshotReady = { 2 };
+int snapshotBack = 1;
+int snapshotFront = 0;
+Uint32 snapshotSequence = 0;
 
 // ---------------------------------------------------------
-// Glyph textures
+// Glyph atlas
 // ---------------------------------------------------------
+#define ATLAS_WIDTH            512
+#define ATLAS_PADDING          1
+#define GLYPH_BATCH_QUADS      8192
+
+// The alphabet rasterized once by font1, packed into one coverage sheet
+// (glyphs are grey on black). The sprites below are baked from it.
+typedef struct {
+    int width;
+    int height;
+    SDL_Rect  src[ALPHABET_SIZE];   // pixel rect of each glyph in the sheet
+    Uint8*    coverage;             // width x height
+} GlyphAtlas;
+
+GlyphAtlas atlas = { 0 };
+
+// Glyph sprites, baked at startup from the atlas with a CPU blur: a trail
+// sprite (the glyph at cell size plus a soft glow) and a head sprite (the
+// 110% copy under the normal one plus a wider halo). Each is cell-sized
+// with a SPRITE_PAD border and drawn unscaled and additively, so a glyph
+// and its bloom are one quad. Sprites are grey, coloured by the vertex.
+#define SPRITE_GLOW_STRENGTH   0.45f   // trail glow, relative to the glyph
+#define SPRITE_HALO_STRENGTH   0.80f   // head halo
+
+enum {
+    SPRITE_TRAIL = 0,
+    SPRITE_HEAD,
+    SPRITE_KINDS
+};
+
+typedef struct {
+    SDL_Texture* texture;          // SDL_BLENDMODE_ADD
+    int          pad;              // border around the cell on each side
+    int          width;            // cell + 2 * pad
+    int          height;
+    Uint8*       coverage;         // CPU copy, width x height per sprite, [glyph * SPRITE_KINDS + kind]
+    SDL_FRect    uv[ALPHABET_SIZE * SPRITE_KINDS];
+} GlyphSprites;
+
+GlyphSprites sprites = { 0 };
+
+// On-disk copy of the baked sprites (sheet pixels and CPU coverage) plus
+// the cell size, so a warm start skips SDL_ttf and the blur entirely. The
+// file lives in the SDL pref path and is keyed by the font file's bytes,
+// FONT_SIZE and the alphabet; bump ATLAS_CACHE_VERSION whenever the bake
+// changes. It is memory-mapped and the sheet uploaded straight from it.
+#define ATLAS_CACHE_FILE       "glyphs.cache"
+#define ATLAS_CACHE_MAGIC      0x3143474Du   // "MGC1" in file byte order
+#define ATLAS_CACHE_VERSION    1
+
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint64 fontHash;        // FNV-1a of FONT_FILE
+    Uint64 alphabetHash;    // FNV-1a of the alphabet strings
+    Uint64 payloadHash;     // FNV-1a of everything after the header
+    Sint32 fontSize;
+    Sint32 cellW, cellH;    // emptyTextureWidth/Height
+    Sint32 pad;             // sprites.pad, width and height
+    Sint32 spriteW, spriteH;
+    Sint32 sheetW, sheetH;  // followed by sheetW x sheetH RGBA32, then sprite coverage
+} AtlasCacheHeader;
+
+typedef struct {
+    bool   disabled;        // --no-atlas-cache
+    bool   hit;
+    Uint64 fontHash;        // 0 = font file unreadable, cache not used
+    Uint64 alphabetHash;
+    double ms;              // time to a usable sprite texture, hit or miss
+} AtlasCache;
+
+AtlasCache atlasCache = { 0 };
+
+// Per-frame vertex/index stream for sprite quads (4 vertices, 6 indices each).
 typedef struct {
-    SDL_Texture* head;
-} glyphTextures;
+    SDL_Vertex* vertices;
+    int* indices;
+    int quadCount;
+} GlyphBatch;
 
-glyphTextures gTextures[ALPHABET_SIZE] = { 0 };
-SDL_Texture* emptyTexture = NULL;
+GlyphBatch glyphBatch = { 0 };
 
 // ---------------------------------------------------------
 // SDL app state
@@ -149,7 +375,6 @@ typedef struct {
 
 SDL2APP app = { .renderer = NULL, .window = NULL, .running = 1, .dy = 20 };
 
-SDL_Rect** glyph = NULL;
 SDL_DisplayMode DM = { .w = 0, .h = 0 };
 
 /*
@@ -182,38 +407,419 @@ typedef struct {
 UIState ui = { 0 };
 static SDL_Rect ui_panel_rect = { 40, 40, UI_PANEL_WIDTH, UI_PANEL_HEIGHT };
 
+// Rendered text, keyed by (string, colours, font), least recently used
+// entry evicted first.
+#define TEXT_CACHE_SIZE     64
+#define TEXT_CACHE_KEY_MAX  48
+
+typedef struct {
+    char         text[TEXT_CACHE_KEY_MAX];
+    SDL_Color    fg;
+    SDL_Color    bg;
+    TTF_Font*    font;
+    SDL_Texture* texture;      // NULL = empty slot
+    Uint32       lastUsed;
+} TextCacheEntry;
+
+typedef struct {
+    TextCacheEntry entries[TEXT_CACHE_SIZE];
+    Uint32         clock;
+    SDL_Texture*   scratch;      // last string too long to cache
+} TextCache;
+
+TextCache textCache = { 0 };
+
+// Panel pixels, redrawn only when the values it shows change.
+typedef struct {
+    SDL_Texture* target;
+    bool         valid;
+    bool         unsupported;    // renderer lacks targets or custom blending
+    int          simulationFPS;  // values the target was drawn with
+    int          colorMode;
+} OverlayCache;
+
+OverlayCache overlayCache = { 0 };
+
+// ---------------------------------------------------------
+// Headless benchmark mode (--bench)
+// ---------------------------------------------------------
+#define BENCH_DEFAULT_FRAMES   1200
+#define BENCH_DEFAULT_WIDTH    1920
+#define BENCH_DEFAULT_HEIGHT   1080
+#define BENCH_DEFAULT_SEED     1337u
+#define BENCH_DEFAULT_REFRESH  60      // simulated display refresh, Hz
+
+typedef struct {
+    int          enabled;
+    int          frames;
+    int          width;
+    int          height;
+    unsigned int seed;
+    int          seedSet;
+    int          refreshHz;
+    SDL_Surface* target;   // offscreen surface behind the software renderer
+} BenchConfig;
+
+BenchConfig bench = {
+    .enabled = 0,
+    .frames = BENCH_DEFAULT_FRAMES,
+    .width = BENCH_DEFAULT_WIDTH,
+    .height = BENCH_DEFAULT_HEIGHT,
+    .seed = BENCH_DEFAULT_SEED,
+    .seedSet = 0,
+    .refreshHz = BENCH_DEFAULT_REFRESH,
+    .target = NULL
+};
+
+// ---------------------------------------------------------
+// Simulation thread
+// ---------------------------------------------------------
+// The simulation runs on its own clock: the thread keeps an accumulator,
+// steps whenever a whole step is owed, publishes a snapshot and sleeps
+// until the next step is due. The render loop never waits for it; it
+// draws whatever snapshot_acquire() returns. Settings cross over through
+// atomics and are picked up before each batch of steps. Without a thread
+// (or under --bench, which needs reproducible frames) the main thread
+// steps inline on its own accumulator instead.
+typedef struct {
+    SDL_Thread*  thread;
+    SDL_sem*     wake;        // ends the thread's sleep early: quit or new settings
+    SDL_atomic_t quit;
+    SDL_atomic_t fps;         // main thread: simulationFPS to step at
+    SDL_atomic_t spawnMode;   // main thread: headColorMode to spawn with
+
+    // Owned by whoever steps (the thread, or the main thread inline).
+    int    colorMode;         // headColorMode to spawn with
+    float  stepMs;            // step length, for time-based effects
+    double droppedMs;         // time cut at MAX_ACCUMULATOR_MS
+    double busyMs;            // totals, read by --bench after inline runs
+    double publishMs;
+    long long publishes;
+    long long glyphsCopied;   // glyphs written into snapshots
+} SimThread;
+
+SimThread simThread = { 0 };
+
+// Render interpolation (--no-interp turns it off). Each frame is drawn at
+// the fraction of the next step that has elapsed since the shown snapshot's
+// state was due (snapshot_alpha()): fades follow interpolated travel and heads
+// glide at their continuous position instead of jumping a cell per step.
+bool renderInterpolate = true;
+
+// Phosphor pipeline (--phosphor, P to toggle). Trails persist in an
+// accumulation target that is darkened by a multiplicative pass, and only
+// glyphs spawned since the previous frame are drawn into it, so the
+// per-frame cost follows the spawn rate instead of the number of visible
+// glyphs. Heads go on top of the composited buffer every frame and never
+// enter it. The decay is per unit of time, an approximation of the exact
+// per-travel fade; the half-life is in simulation steps so it follows the
+// simulation rate.
+//
+// The decay is applied in whole elapsed simulation steps, not per frame,
+// so it does not depend on the refresh rate: a per-frame factor rounds to
+// 8 bits (253/255 at 144 Hz) and stalls on values whose product rounds
+// back to themselves, and a per-frame subtract took a unit per frame. The
+// factor's rounding error is carried into the next application. What is
+// left is the subtract's unit per step, which shortens the mid-range
+// half-life to about 16 steps at every refresh rate, and up to one frame
+// of phase.
+#define PHOSPHOR_HALF_LIFE_STEPS  18.0f   // ~ where the exact fade halves at average speed
+
+typedef struct {
+    bool          enabled;
+    bool          unsupported;   // renderer has no render targets
+    bool          resync;        // buffer must be cleared and refilled from the snapshot
+    SDL_Texture*  target;
+    bool          canSubtract;   // custom REV_SUBTRACT blending clears 8-bit residue
+    SDL_BlendMode subtract;
+    Uint32*       drawnSerial;   // per column: serial of the next glyph to draw
+    float         decayMs;       // elapsed time not yet decayed, under one step
+    float         halvingsOwed;  // decay the 8-bit factor could not express yet
+} PhosphorState;
+
+PhosphorState phosphor = { 0 };
+
+// Without interpolation the trail layer only changes when a new snapshot
+// arrives (plus the frame after, when flashed heads go out). The last
+// drawn layer is kept in a target and re-presented while nothing changed.
+//
+// This only helps with --no-interp. In the default interpolated mode every
+// frame is drawn at its own alpha, so two frames share a (sequence, alpha)
+// key only if alpha is bucketed coarser than the refresh interval, which
+// is the stepping that interpolation removes. Keeping the target there
+// would add a full-screen copy to every frame and almost never hit.
+typedef struct {
+    SDL_Texture* target;
+    bool         valid;
+    bool         unsupported;   // renderer has no render targets
+    Uint32       sequence;      // what the target was drawn from
+    bool         fresh;
+    int          colorMode;
+    float        fadeDistance;
+} FrameCache;
+
+FrameCache frameCache = { 0 };
+
+// Views (--views N): the same snapshot drawn N times in a grid. Rendering
+// reads only the snapshot, so extra views cost draw time but no simulation.
+// WAVE and RAINBOW take their colours from the glyphs, which were coloured
+// once at spawn in headColorMode, so only the first view (headColorMode
+// itself) can show a hue mode; the others show the solid modes that
+// follow it (render_view_color_mode()).
+#define MAX_RENDER_VIEWS  4
+
+typedef struct {
+    SDL_Rect viewport;      // output pixels
+    float    scale;         // simulation pixels -> output pixels
+} RenderView;
+
+RenderView renderViews[MAX_RENDER_VIEWS];
+int        renderViewCount = 1;
+int        renderViewsW = 0, renderViewsH = 0;   // output size of the layout
+
+// ---------------------------------------------------------
+// CPU compositor
+// ---------------------------------------------------------
+// For renderers without a usable GPU (--compose cpu, or auto on a software
+// renderer): the trail layer is composited on the CPU straight into a
+// streaming texture and presented with one copy. The screen is split into
+// COMPOSE_BAND_WIDTH-wide vertical bands that workers claim from a shared
+// cursor; every band walks the snapshot and adds the glyph sprites that
+// touch it, clipped to itself, as the GPU path blends them.
+#define COMPOSE_BAND_WIDTH    128   // pixels, a multiple of the widest SIMD step
+#define COMPOSE_MAX_WORKERS   15
+
+enum {
+    COMPOSE_AUTO = 0,   // CPU on software renderers, outside --bench
+    COMPOSE_GPU,
+    COMPOSE_CPU
+};
+
+typedef struct {
+    int          request;       // COMPOSE_*
+    bool         enabled;
+    SDL_Texture* texture;       // streaming framebuffer at output size
+    int          width;
+    int          height;
+
+    SDL_Thread*  threads[COMPOSE_MAX_WORKERS];
+    int          count;         // worker threads (the main thread also works)
+    SDL_sem*     start;
+    SDL_sem*     done;
+    SDL_atomic_t cursor;        // next unclaimed band
+    SDL_atomic_t quit;
+    SDL_atomic_t glyphCount;    // result: glyphs composited, for renderStats
+
+    // Job, written by the main thread while the workers wait.
+    const RenderSnapshot* snap;
+    float   alpha;
+    bool    freshSnapshot;
+    bool    hueShaded;
+    Uint32* pixels;
+    int     pitch;              // in pixels
+    int     bandCount;
+} CpuCompositor;
+
+CpuCompositor compositor = { 0 };
+
+// ---------------------------------------------------------
+// Frame clock / pacing
+// ---------------------------------------------------------
+// Frame times come from the performance counter. With --fps-cap the
+// renderer is created without vsync and frame_pacer_wait() holds each
+// frame to a fixed period: it sleeps until PACING_SPIN_MS before the
+// deadline, then spins. Time the loop throws away is counted, not hidden.
+#define PACING_SPIN_MS   2.0
+
+typedef struct {
+    Uint64 frequency;
+    Uint64 last;             // counter at the previous frame start
+    Uint64 deadline;         // pacing: earliest start of the next frame
+    int    capFPS;           // --fps-cap; 0 = presentation (vsync) paces the loop
+
+    Uint64 frames;
+    Uint64 clampedFrames;    // frames longer than MAX_FRAME_TIME_MS
+    double clampedMs;        // time cut from those frames
+    double droppedMs;        // accumulated time discarded at MAX_ACCUMULATOR_MS
+    double maxFrameMs;
+} FrameClock;
+
+FrameClock frameClock = { 0 };
+
+// Startup is timed from the top of main(). Audio (device open and music
+// decode) runs on its own thread and the glyph sprites are loaded or baked
+// on another while the window and renderer come up; the main thread only
+// waits for the sprites, right before their upload.
+typedef struct {
+    Uint64      start;
+    double      firstFrameMs;   // first present, 0 until then
+    double      audioMs;        // music playing, set by the audio thread
+    SDL_Thread* audioThread;
+    SDL_Thread* spriteThread;   // sprite_loader_main()
+} StartupState;
+
+StartupState startup = { 0 };
+
+static inline double startup_elapsed_ms(void) {
+    return (double)(SDL_GetPerformanceCounter() - startup.start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+}
+
+static void startup_join(SDL_Thread** thread) {
+    if (!*thread) return;
+    SDL_WaitThread(*thread, NULL);
+    *thread = NULL;
+}
+
+// Counters filled in by render_glyph_trails(), reset by the caller.
+typedef struct {
+    int glyphs;
+    int drawCalls;
+    int framesReused;    // frames that re-presented frameCache instead of drawing trails
+} RenderStats;
+
+RenderStats renderStats = { 0 };
+
+// Hot kernel variants, chosen once by simd_init() from SDL's CPU feature
+// queries; --simd forces one for A/B runs.
+enum {
+    SIMD_SCALAR = 0,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_NEON,
+    SIMD_LEVEL_COUNT
+};
+
+static const char* const simdLevelNames[SIMD_LEVEL_COUNT] = { "scalar", "sse2", "avx2", "neon" };
+
+typedef struct {
+    int  request;     // --simd, -1 = best available
+    int  level;       // SIMD_* in use
+    int  (*speedModulate)(const int* cols, int count);   // columns done, the rest go scalar
+    void (*spriteSpan)(Uint32* dst, const Uint8* mask, int n, SDL_Color c);
+} SimdDispatch;
+
+SimdDispatch simd = { .request = -1 };
+
 // ---------------------------------------------------------
 // Function declarations
 // ---------------------------------------------------------
-void render_glyph_trails(void);
+void render_glyph_trails(const RenderSnapshot* snap, float alpha, bool freshSnapshot, int colorMode);
 void initialize(void);
 void terminate(int exit_code);
 void cleanupMemory(void);
-void spawnStaticGlyph(int columnIndex, int glyphIndex, SDL_Rect rect, float initialFade, bool isHead);
-int  spawn(void);
+void sim_pool_shutdown(void);
+void sim_thread_shutdown(void);
+void cpu_compositor_shutdown(void);
+void spawnStaticGlyph(int columnIndex, int glyphIndex, int row, float initialFade, RandStream* rs);
+int  spawn(RandStream* pick);
 int  move(int i);
 
 void render_ui_overlay(void);
+void simulate_step(void);
+void render_frame(const RenderSnapshot* snap, float alpha, float frameMs);
+void run_benchmark(void);
 
 // ---------------------------------------------------------
 // Helpers
 // ---------------------------------------------------------
 
-static float frand01(void) {
-    return (float)rand() / (float)RAND_MAX;
+// Counter-based random numbers. Every draw is a pure hash of
+// (seed, column, tick, purpose, counter), so a column's sequence does not
+// depend on the order columns are simulated in, and runs are identical on
+// every platform for a given seed.
+static Uint64 splitmix64(Uint64 z) {
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static RandStream rand_stream(int column, int purpose) {
+    Uint64 lane = ((Uint64)(Uint32)column << 8) | (Uint64)(Uint8)purpose;
+    RandStream rs;
+    rs.key = splitmix64(randSeed ^ splitmix64((lane << 32) ^ (Uint64)simTick));
+    rs.counter = 0;
+    return rs;
+}
+
+static inline Uint32 rand_next(RandStream* rs) {
+    return (Uint32)(splitmix64(rs->key + (Uint64)rs->counter++) >> 32);
+}
+
+// Uniform integer in [0, n) without a division (multiply-shift).
+static inline int rand_below(RandStream* rs, int n) {
+    return (int)(((Uint64)rand_next(rs) * (Uint64)(Uint32)n) >> 32);
 }
 
-static float frand_range(float a, float b) {
-    return a + (b - a) * frand01();
+static float frand01(RandStream* rs) {
+    return (float)(rand_next(rs) >> 8) * (1.0f / 16777216.0f);
 }
 
-static int irand_range(int a, int b) {
+static float frand_range(RandStream* rs, float a, float b) {
+    return a + (b - a) * frand01(rs);
+}
+
+static int irand_range(RandStream* rs, int a, int b) {
     // Inclusive range [a, b]
     if (b <= a) return a;
-    return a + (rand() % (b - a + 1));
+    return a + rand_below(rs, b - a + 1);
+}
+
+static bool column_set_init(ColumnSet* set, int capacity) {
+    set->items = (int*)malloc((size_t)capacity * sizeof(int));
+    set->pos = (int*)malloc((size_t)capacity * sizeof(int));
+    set->count = 0;
+    if (!set->items || !set->pos) return false;
+    for (int i = 0; i < capacity; ++i) set->pos[i] = -1;
+    return true;
+}
+
+static inline void column_set_add(ColumnSet* set, int col) {
+    if (set->pos[col] >= 0) return;
+    set->pos[col] = set->count;
+    set->items[set->count++] = col;
+}
+
+static inline void column_set_remove(ColumnSet* set, int col) {
+    int at = set->pos[col];
+    if (at < 0) return;
+    int last = set->items[--set->count];
+    set->items[at] = last;
+    set->pos[last] = at;
+    set->pos[col] = -1;
+}
+
+static inline StaticGlyph* column_trail(int col) {
+    return &fadingTrails[(size_t)col * MAX_TRAIL_LENGTH];
+}
+
+static inline SDL_Rect glyph_rect(int col, const StaticGlyph* g) {
+    SDL_Rect r = {
+        mn[col],
+        glyph_START_Y + (int)g->row * emptyTextureHeight,
+        emptyTextureWidth,
+        emptyTextureHeight
+    };
+    return r;
+}
+
+// The rain itself may come from the glyph cache without touching SDL_ttf,
+// so font1 is opened on first use by whoever needs it.
+TTF_Font* ui_font(void) {
+    static bool failed = false;
+    if (font1 || failed) return font1;
+
+    font1 = TTF_OpenFont(FONT_FILE, FONT_SIZE);
+    if (!font1) {
+        SDL_Log("TTF_OpenFont failed: %s", TTF_GetError());
+        failed = true;
+    }
+    return font1;
 }
 
 SDL_Texture* createTextTexture(const char* text, SDL_Color fg, SDL_Color bg) {
+    if (!ui_font()) return NULL;
+
     SDL_Surface* surface = TTF_RenderText_Shaded(font1, text, fg, bg);
     if (!surface)
         return NULL;
@@ -223,6 +829,61 @@ SDL_Texture* createTextTexture(const char* text, SDL_Color fg, SDL_Color bg) {
     return texture;
 }
 
+static inline bool color_equal(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Cached createTextTexture(). The texture stays owned by the cache and is
+// valid until TEXT_CACHE_SIZE other strings have been requested since.
+// Strings too long for a key are rendered again on every call and stay
+// valid until the next such call.
+SDL_Texture* text_cache_get(const char* text, SDL_Color fg, SDL_Color bg) {
+    size_t len = strlen(text);
+    TextCacheEntry* slot = NULL;
+
+    if (len >= TEXT_CACHE_KEY_MAX) {
+        if (textCache.scratch) SDL_DestroyTexture(textCache.scratch);
+        textCache.scratch = createTextTexture(text, fg, bg);
+        return textCache.scratch;
+    }
+
+    textCache.clock++;
+
+    for (int i = 0; i < TEXT_CACHE_SIZE; ++i) {
+        TextCacheEntry* e = &textCache.entries[i];
+        if (e->texture && e->font == font1 && color_equal(e->fg, fg) && color_equal(e->bg, bg) &&
+            strcmp(e->text, text) == 0) {
+            e->lastUsed = textCache.clock;
+            return e->texture;
+        }
+    }
+
+    // Miss: reuse an empty slot or the least recently used one.
+    for (int i = 0; i < TEXT_CACHE_SIZE; ++i) {
+        TextCacheEntry* e = &textCache.entries[i];
+        if (!slot || !e->texture || e->lastUsed < slot->lastUsed) slot = e;
+        if (!e->texture) break;
+    }
+
+    if (slot->texture) SDL_DestroyTexture(slot->texture);
+
+    slot->texture = createTextTexture(text, fg, bg);
+    slot->font = font1;
+    slot->fg = fg;
+    slot->bg = bg;
+    slot->lastUsed = textCache.clock;
+    memcpy(slot->text, text, len + 1);
+    return slot->texture;
+}
+
+static void text_cache_clear(void) {
+    for (int i = 0; i < TEXT_CACHE_SIZE; ++i) {
+        if (textCache.entries[i].texture) SDL_DestroyTexture(textCache.entries[i].texture);
+        textCache.entries[i].texture = NULL;
+    }
+    if (textCache.scratch) { SDL_DestroyTexture(textCache.scratch); textCache.scratch = NULL; }
+}
+
 static inline Uint8 clamp_u8_float(float v) {
     if (v <= 0.0f) return 0;
     if (v >= 255.0f) return 255;
@@ -254,7 +915,7 @@ SDL_Rect render_multicolor_text(const char* text,
         chStr[0] = text[i];
         chStr[1] = '\0';
 
-        SDL_Texture* tex = createTextTexture(chStr, colors[i], bg);
+        SDL_Texture* tex = text_cache_get(chStr, colors[i], bg);
         if (!tex) continue;
 
         int tw, th;
@@ -265,8 +926,6 @@ SDL_Rect render_multicolor_text(const char* text,
             SDL_RenderCopy(app.renderer, tex, NULL, &dst);
         }
 
-        SDL_DestroyTexture(tex);
-
         if (tw > 0) {
             cx += tw;
             if (th > maxH) maxH = th;
@@ -283,51 +942,53 @@ SDL_Rect render_multicolor_text(const char* text,
 // Cleanup
 // ---------------------------------------------------------
 void cleanupMemory() {
-    if (mn) { free(mn); mn = NULL; }
-    if (speed) { free(speed); speed = NULL; }
-    if (isActive) { free(isActive); isActive = NULL; }
-    if (headGlyphIndex) { free(headGlyphIndex); headGlyphIndex = NULL; }
-    if (VerticalAccumulator) { free(VerticalAccumulator); VerticalAccumulator = NULL; }
-    if (ColumnTravel) { free(ColumnTravel); ColumnTravel = NULL; }
-    if (SpeedFactor) { free(SpeedFactor); SpeedFactor = NULL; }
-    if (SpeedTarget) { free(SpeedTarget); SpeedTarget = NULL; }
-    if (SpeedPhase) { free(SpeedPhase); SpeedPhase = NULL; }
-    if (SpeedPhaseStep) { free(SpeedPhaseStep); SpeedPhaseStep = NULL; }
-    if (SpeedRetargetTimer) { free(SpeedRetargetTimer); SpeedRetargetTimer = NULL; }
-
-    if (glyph) {
-        for (int i = 0; i < RANGE; ++i) {
-            if (glyph[i]) { free(glyph[i]); glyph[i] = NULL; }
-        }
-        free(glyph);
-        glyph = NULL;
-    }
-
-    if (fadingTrails) {
-        for (int i = 0; i < RANGE; ++i) {
-            if (fadingTrails[i]) { free(fadingTrails[i]); fadingTrails[i] = NULL; }
-        }
-        free(fadingTrails);
-        fadingTrails = NULL;
-    }
-
-    if (trailCounts) { free(trailCounts); trailCounts = NULL; }
-    if (freeIndexList) { free(freeIndexList); freeIndexList = NULL; }
-
-    for (int i = 0; i < ALPHABET_SIZE; ++i) {
-        if (gTextures[i].head) {
-            SDL_DestroyTexture(gTextures[i].head);
-            gTextures[i].head = NULL;
-        }
-    }
-
-    if (emptyTexture) {
-        SDL_DestroyTexture(emptyTexture);
-        emptyTexture = NULL;
+    sim_thread_shutdown();
+    sim_pool_shutdown();
+    cpu_compositor_shutdown();
+
+    if (columnArena) { SDL_SIMDFree(columnArena); columnArena = NULL; }
+    mn = NULL; isActive = NULL; headGlyphIndex = NULL; HeadY = NULL;
+    speed = NULL; VerticalAccumulator = NULL; ColumnTravel = NULL; ColumnMovement = NULL;
+    SpeedFactor = NULL; SpeedTarget = NULL; SpeedPhase = NULL;
+    SpeedPhaseStep = NULL; SpeedRetargetTimer = NULL;
+
+    if (fadingTrails) { free(fadingTrails); fadingTrails = NULL; }
+
+    if (trailHead) { free(trailHead); trailHead = NULL; }
+    if (trailTail) { free(trailTail); trailTail = NULL; }
+    if (headPending) { free(headPending); headPending = NULL; }
+    if (phosphor.drawnSerial) { free(phosphor.drawnSerial); phosphor.drawnSerial = NULL; }
+    for (int i = 0; i < SNAPSHOT_COUNT; ++i) {
+        if (snapshots[i].columns) { free(snapshots[i].columns); snapshots[i].columns = NULL; }
+        if (snapshots[i].glyphs) { free(snapshots[i].glyphs); snapshots[i].glyphs = NULL; }
+        if (snapshots[i].copiedHead) { free(snapshots[i].copiedHead); snapshots[i].copiedHead = NULL; }
+        snapshots[i].columnCount = 0;
     }
+    if (freeColumns.items) { free(freeColumns.items); freeColumns.items = NULL; }
+    if (freeColumns.pos) { free(freeColumns.pos); freeColumns.pos = NULL; }
+    freeColumns.count = 0;
+    if (liveColumns.items) { free(liveColumns.items); liveColumns.items = NULL; }
+    if (liveColumns.pos) { free(liveColumns.pos); liveColumns.pos = NULL; }
+    liveColumns.count = 0;
+
+    if (glyphBatch.vertices) { free(glyphBatch.vertices); glyphBatch.vertices = NULL; }
+    if (glyphBatch.indices) { free(glyphBatch.indices); glyphBatch.indices = NULL; }
+    glyphBatch.quadCount = 0;
+    if (atlas.coverage) { free(atlas.coverage); atlas.coverage = NULL; }
+    if (sprites.texture) { SDL_DestroyTexture(sprites.texture); sprites.texture = NULL; }
+    if (sprites.coverage) { free(sprites.coverage); sprites.coverage = NULL; }
+
+    text_cache_clear();
+    if (phosphor.target) { SDL_DestroyTexture(phosphor.target); phosphor.target = NULL; }
+    if (frameCache.target) { SDL_DestroyTexture(frameCache.target); frameCache.target = NULL; }
+    frameCache.valid = false;
+    if (overlayCache.target) { SDL_DestroyTexture(overlayCache.target); overlayCache.target = NULL; }
+    overlayCache.valid = false;
 }
 
 void terminate(int exit_code) {
+    startup_join(&startup.spriteThread);
+    startup_join(&startup.audioThread);
     cleanupMemory();
 
     if (music) Mix_FreeMusic(music);
@@ -339,6 +1000,7 @@ void terminate(int exit_code) {
 
     if (app.renderer) SDL_DestroyRenderer(app.renderer);
     if (app.window)   SDL_DestroyWindow(app.window);
+    if (bench.target) SDL_FreeSurface(bench.target);
 
     SDL_Quit();
     exit(exit_code);
@@ -377,272 +1039,904 @@ void hueToRGBf(float H, float* r, float* g, float* b) {
     if (*b < 0.0f) *b = 0.0f; else if (*b > 255.0f) *b = 255.0f;
 }
 
-void updateHue() {
-    if (headColorMode == 4) {
-        WaveHue += 0.1f;
+// Base (dim) and head (bright) colours of the solid modes. WAVE/RAINBOW
+// get the green defaults; their colours are per glyph.
+static void color_mode_palette(int mode,
+    float* baseR, float* baseG, float* baseB, float* headR, float* headG, float* headB) {
+    // Defaults (GREEN)
+    *baseR = 0.0f;  *baseG = 128.0f; *baseB = 0.0f;     // CRT phosphor base (dim)
+    *headR = 80.0f; *headG = 255.0f; *headB = 110.0f;   // CRT phosphor head (bright)
+
+    switch (mode) {
+    case 1: // RED (Predator red)
+        // Deep, aggressive red with minimal blue to avoid magenta/pink.
+        *baseR = 128.0f; *baseG = 0.0f; *baseB = 0.0f;
+        *headR = 255.0f; *headG = 90.0f; *headB = 90.0f;
+        break;
+    case 2: // BLUE (digital)
+        *baseR = 0.0f;   *baseG = 0.0f;   *baseB = 185.0f;
+        *headR = 120.0f; *headG = 160.0f; *headB = 255.0f;
+        break;
+    case 3: // WHITE
+        *baseR = 128.0f; *baseG = 128.0f; *baseB = 128.0f;
+        *headR = 255.0f; *headG = 255.0f; *headB = 255.0f;
+        break;
+    default:
+        break;
+    }
+}
+
+// Simulation thread, once per step: the wave moves with simulated time,
+// not with how often frames are drawn.
+static void advance_wave_hue(void) {
+    if (simThread.colorMode == 4) {
+        WaveHue += WAVE_HUE_DEG_PER_SEC * simThread.stepMs / 1000.0f;
         if (WaveHue >= 360.0f) WaveHue -= 360.0f;
     }
 }
 
 // ---------------------------------------------------------
-// Rendering
+// Fade lookup tables
 // ---------------------------------------------------------
-void render_glyph_trails(void) {
-    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_ADD);
+// Everything the trail shading derives from a glyph's fade, quantized by
+// distance since spawn: bucket = distance * FADE_LUT_SIZE / FadeDistance.
+// WAVE/RAINBOW glyphs scale their stored head colour by hueScale instead.
+// One table per colour mode, so views in different modes share them.
+// fade_lut_update() selects a mode's table and rebuilds it whenever
+// FadeDistance differs from its last build.
+#define FADE_LUT_SIZE       1024
+#define HUE_SCALE_SHIFT     15
 
-    updateHue();
-
-    for (int col = 0; col < RANGE; col++) {
-        int count = trailCounts[col];
-        if (count <= 0) continue;
-
-        int writeIndex = 0;
-        float colTravel = ColumnTravel[col];
-
-        // Defaults (GREEN)
-        float baseR = 0.0f, baseG = 128.0f, baseB = 0.0f;   // CRT phosphor base (dim)
-        float headR = 80.0f, headG = 255.0f, headB = 110.0f;  // CRT phosphor head (bright)
-
-        // For non-rainbow modes, we compute colors per-frame based on headColorMode.
-        // For rainbow mode, colors are computed PER GLYPH from its stored spawnHue.
-        if (headColorMode != 5) {
-            switch (headColorMode) {
-            case 1: // RED (Predator red)
-                // Deep, aggressive red with minimal blue to avoid magenta/pink.
-                baseR = 128.0f; baseG = 0.0f; baseB = 0.0f;
-                headR = 255.0f; headG = 90.0f; headB = 90.0f;
-                break;
-            case 2: // BLUE (digital)
-                baseR = 0.0f;   baseG = 0.0f;  baseB = 185.0f;
-                headR = 120.0f;   headG = 160.0f; headB = 255.0f;
-                break;
-            case 3: // WHITE
-                baseR = 128.0f; baseG = 128.0f; baseB = 128.0f;
-                headR = 255.0f; headG = 255.0f; headB = 255.0f;
-                break;
-            default:
-                break;
-            }
-        }
+typedef struct {
+    int       mode;                          // colour mode of the last build, -1 = none
+    float     fadeDistance;                  // FadeDistance of the last build
+    float     scale;                         // distance -> bucket
+    SDL_Color head;                          // solid modes: head colour
+    SDL_Color trail[FADE_LUT_SIZE];          // solid modes: glyph and glow colour
+    Uint16    hueScale[FADE_LUT_SIZE];       // hue modes: glyph = head * hueScale >> HUE_SCALE_SHIFT
+} FadeLut;
+
+#define COLOR_MODE_COUNT    6
+
+FadeLut  fadeLuts[COLOR_MODE_COUNT];
+FadeLut* fadeLut = &fadeLuts[0];             // table of the view being drawn
+
+// Trail glyph colour at a squared fade factor: base scaled up to full
+// brightness, then a short lerp to the head colour at the very top.
+static SDL_Color shade_trail(float fadeFactor,
+    float baseR, float baseG, float baseB, float headR, float headG, float headB) {
+    const float brightThreshold = 0.9f;
+
+    float tBright = (fadeFactor - brightThreshold) / (1.0f - brightThreshold);
+    float tNormal = fadeFactor / brightThreshold;
+
+    if (tBright < 0.0f) tBright = 0.0f;
+    if (tBright > 1.0f) tBright = 1.0f;
+    if (tNormal < 0.0f) tNormal = 0.0f;
+    if (tNormal > 1.0f) tNormal = 1.0f;
+
+    SDL_Color c = { 0, 0, 0, 255 };
+    if (fadeFactor > brightThreshold) {
+        c.r = (Uint8)(baseR + tBright * (headR - baseR));
+        c.g = (Uint8)(baseG + tBright * (headG - baseG));
+        c.b = (Uint8)(baseB + tBright * (headB - baseB));
+    }
+    else {
+        c.r = (Uint8)(tNormal * baseR);
+        c.g = (Uint8)(tNormal * baseG);
+        c.b = (Uint8)(tNormal * baseB);
+    }
+    return c;
+}
 
-        const float brightThreshold = 0.9f;
+// shade_trail() for a base of half the head colour, as a factor on the head.
+static float shade_trail_half_base(float fadeFactor) {
+    const float brightThreshold = 0.9f;
 
-        for (int g = 0; g < count; g++) {
-            StaticGlyph* SGlyph = &fadingTrails[col][g];
+    if (fadeFactor > brightThreshold) {
+        float tBright = (fadeFactor - brightThreshold) / (1.0f - brightThreshold);
+        if (tBright > 1.0f) tBright = 1.0f;
+        return 0.50f + 0.50f * tBright;
+    }
 
-            float distanceSinceSpawn = colTravel - SGlyph->fadeTimer;
-            if (distanceSinceSpawn < 0.0f) distanceSinceSpawn = 0.0f;
+    float tNormal = fadeFactor / brightThreshold;
+    if (tNormal < 0.0f) tNormal = 0.0f;
+    return 0.50f * tNormal;
+}
 
-            float fadeFactor = 1.0f - (distanceSinceSpawn / FadeDistance);
-            if (fadeFactor <= 0.0f) {
-                continue;
-            }
-            if (fadeFactor > 1.0f) fadeFactor = 1.0f;
+// Squared fade factor at the near edge of a bucket.
+static inline float fade_lut_factor(int bucket, int size) {
+    float f = 1.0f - (float)bucket / (float)size;
+    return f * f;
+}
 
-            fadeFactor = fadeFactor * fadeFactor;
+static void fade_lut_build(FadeLut* lut, int mode) {
+    lut->mode = mode;
+    lut->fadeDistance = FadeDistance;
+    lut->scale = (float)FADE_LUT_SIZE / FadeDistance;
 
-            SDL_Texture* texture = gTextures[SGlyph->glyphIndex].head;
+    float baseR, baseG, baseB, headR, headG, headB;
+    color_mode_palette(mode, &baseR, &baseG, &baseB, &headR, &headG, &headB);
 
-            // If we are in rainbow mode, compute this glyph's base/head from its stored spawnHue.
-            float gBaseR = baseR, gBaseG = baseG, gBaseB = baseB;
-            float gHeadR = headR, gHeadG = headG, gHeadB = headB;
+    SDL_Color head = { clamp_u8_float(headR), clamp_u8_float(headG), clamp_u8_float(headB), 255 };
+    lut->head = head;
 
-            if (headColorMode == 5 || headColorMode == 4) {
-                // RAINBOW/WAVE: render from per-glyph stored hue
-                hueToRGBf(SGlyph->spawnHue, &gHeadR, &gHeadG, &gHeadB);
+    for (int b = 0; b < FADE_LUT_SIZE; ++b) {
+        float fadeFactor = fade_lut_factor(b, FADE_LUT_SIZE);
 
-                // Same “suite” as GREEN/RED/BLUE/WHITE: base is a dimmer version of head.
-                gBaseR = gHeadR * 0.50f;
-                gBaseG = gHeadG * 0.50f;
-                gBaseB = gHeadB * 0.50f;
-            }
+        lut->trail[b] = shade_trail(fadeFactor, baseR, baseG, baseB, headR, headG, headB);
 
-            if (SGlyph->isHead) {
-                SDL_SetTextureColorMod(texture,
-                    clamp_u8_float(gHeadR),
-                    clamp_u8_float(gHeadG),
-                    clamp_u8_float(gHeadB));
-                SDL_SetTextureAlphaMod(texture, 255);
-
-                SDL_Rect bigRect = SGlyph->rect;
-                int dw = (int)(bigRect.w * 0.1f);
-                int dh = (int)(bigRect.h * 0.1f);
-                bigRect.x -= dw / 2; bigRect.y -= dh / 2;
-                bigRect.w += dw; bigRect.h += dh;
-
-                SDL_RenderCopy(app.renderer, texture, NULL, &bigRect);
-
-                float headBoost = (headColorMode == 0) ? 25.0f : (headColorMode == 1 ? 18.0f : (headColorMode == 2 ? 12.0f : 0.0f));
-                Uint8 brightAlpha = clamp_u8_float(fadeFactor * 255.0f + 100.0f + headBoost);
-                SDL_SetTextureAlphaMod(texture, brightAlpha);
-                SDL_RenderCopy(app.renderer, texture, NULL, &SGlyph->rect);
-            }
-            else {
-                float tBright = (fadeFactor - brightThreshold) / (1.0f - brightThreshold);
-                float tNormal = fadeFactor / brightThreshold;
-
-                if (tBright < 0.0f) tBright = 0.0f;
-                if (tBright > 1.0f) tBright = 1.0f;
-                if (tNormal < 0.0f) tNormal = 0.0f;
-                if (tNormal > 1.0f) tNormal = 1.0f;
-
-                Uint8 r, gCol, b, a = 255;
-
-                if (fadeFactor > brightThreshold) {
-                    float rr = gBaseR + tBright * (gHeadR - gBaseR);
-                    float gg = gBaseG + tBright * (gHeadG - gBaseG);
-                    float bb = gBaseB + tBright * (gHeadB - gBaseB);
-                    r = (Uint8)rr;
-                    gCol = (Uint8)gg;
-                    b = (Uint8)bb;
-                }
-                else {
-                    float rr = tNormal * gBaseR;
-                    float gg = tNormal * gBaseG;
-                    float bb = tNormal * gBaseB;
-                    r = (Uint8)rr;
-                    gCol = (Uint8)gg;
-                    b = (Uint8)bb;
-                }
+        // Same “suite” as GREEN/RED/BLUE/WHITE: base is a dimmer version of head.
+        float k = shade_trail_half_base(fadeFactor);
+        lut->hueScale[b] = (Uint16)(k * (float)(1 << HUE_SCALE_SHIFT) + 0.5f);
+    }
+}
 
-                float glowFactor = fadeFactor * fadeFactor;
+static void fade_lut_update(int mode) {
+    fadeLut = &fadeLuts[mode];
+    if (fadeLut->mode != mode || fadeLut->fadeDistance != FadeDistance)
+        fade_lut_build(fadeLut, mode);
+}
 
-                // Slightly stronger “phosphor bloom” for GREEN/RED/BLUE modes.
-                float glowBoost = (headColorMode == 0) ? 1.35f : (headColorMode == 1 ? 1.25f : (headColorMode == 2 ? 1.15f : 1.0f));
-                float glowA = glowFactor * 50.0f * glowBoost;
-                if (glowA > 255.0f) glowA = 255.0f;
-                Uint8 glowAlpha = (Uint8)(glowA);
+// ---------------------------------------------------------
+// Glyph batching
+// ---------------------------------------------------------
+// Sprites blend additively (sprites.texture is SDL_BLENDMODE_ADD) and
+// saturating adds commute, so when a batch is flushed relative to other
+// additive draws does not change the image. Only the non-additive passes
+// (phosphor decay, the buffer copy under the heads) are order-sensitive.
+static void glyph_batch_flush(void) {
+    if (glyphBatch.quadCount <= 0) return;
+
+    SDL_RenderGeometry(app.renderer, sprites.texture,
+        glyphBatch.vertices, glyphBatch.quadCount * 4,
+        glyphBatch.indices, glyphBatch.quadCount * 6);
+
+    renderStats.drawCalls++;
+    glyphBatch.quadCount = 0;
+}
 
-                SDL_SetRenderDrawColor(app.renderer, r, gCol, b, glowAlpha);
-                SDL_RenderFillRect(app.renderer, &SGlyph->rect);
+static void glyph_batch_push(const SDL_FRect* dst, const SDL_FRect* uv, SDL_Color color) {
+    if (glyphBatch.quadCount >= GLYPH_BATCH_QUADS) glyph_batch_flush();
 
-                SDL_SetTextureColorMod(texture, r, gCol, b);
-                SDL_SetTextureAlphaMod(texture, a);
-                SDL_RenderCopy(app.renderer, texture, NULL, &SGlyph->rect);
-            }
+    SDL_Vertex* v = &glyphBatch.vertices[glyphBatch.quadCount * 4];
 
-            SGlyph->isHead = false;
-            fadingTrails[col][writeIndex++] = *SGlyph;
-        }
+    float x0 = dst->x;
+    float y0 = dst->y;
+    float x1 = dst->x + dst->w;
+    float y1 = dst->y + dst->h;
 
-        trailCounts[col] = writeIndex;
-    }
+    v[0].position.x = x0; v[0].position.y = y0; v[0].tex_coord.x = uv->x;         v[0].tex_coord.y = uv->y;
+    v[1].position.x = x1; v[1].position.y = y0; v[1].tex_coord.x = uv->x + uv->w; v[1].tex_coord.y = uv->y;
+    v[2].position.x = x1; v[2].position.y = y1; v[2].tex_coord.x = uv->x + uv->w; v[2].tex_coord.y = uv->y + uv->h;
+    v[3].position.x = x0; v[3].position.y = y1; v[3].tex_coord.x = uv->x;         v[3].tex_coord.y = uv->y + uv->h;
+    v[0].color = v[1].color = v[2].color = v[3].color = color;
 
-    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+    glyphBatch.quadCount++;
+}
+
+static inline SDL_FRect rect_to_frect(const SDL_Rect* r) {
+    SDL_FRect f = { (float)r->x, (float)r->y, (float)r->w, (float)r->h };
+    return f;
+}
+
+static inline SDL_Color glyph_head_color(const StaticGlyph* g) {
+    SDL_Color c = { g->headR, g->headG, g->headB, 255 };
+    return c;
+}
+
+static inline SDL_Color glyph_scaled_color(const StaticGlyph* g, Uint32 scale) {
+    SDL_Color c = {
+        (Uint8)((g->headR * scale) >> HUE_SCALE_SHIFT),
+        (Uint8)((g->headG * scale) >> HUE_SCALE_SHIFT),
+        (Uint8)((g->headB * scale) >> HUE_SCALE_SHIFT),
+        255
+    };
+    return c;
+}
+
+static inline SDL_Color trail_color(const StaticGlyph* g, int bucket, bool hueShaded) {
+    return hueShaded ? glyph_scaled_color(g, fadeLut->hueScale[bucket]) : fadeLut->trail[bucket];
+}
+
+// Fade bucket of one glyph at the given travel, -1 once faded out.
+static inline int glyph_fade_bucket(const StaticGlyph* g, float travel) {
+    float distanceSinceSpawn = travel - g->fadeTimer;
+    if (distanceSinceSpawn < 0.0f) distanceSinceSpawn = 0.0f;
+    if (distanceSinceSpawn >= FadeDistance) return -1;
+
+    int bucket = (int)(distanceSinceSpawn * fadeLut->scale);
+    return bucket < FADE_LUT_SIZE ? bucket : FADE_LUT_SIZE - 1;
+}
+
+// One sprite quad over a glyph cell: the sprite's border hangs outside it.
+static void push_glyph_sprite(const SDL_FRect* cell, int glyphIndex, int kind, SDL_Color color) {
+    SDL_FRect dst = {
+        cell->x - (float)sprites.pad,
+        cell->y - (float)sprites.pad,
+        (float)sprites.width,
+        (float)sprites.height
+    };
+    color.a = 255;
+    glyph_batch_push(&dst, &sprites.uv[glyphIndex * SPRITE_KINDS + kind], color);
 }
 
 // ---------------------------------------------------------
-// Spawning / movement
+// Rendering
 // ---------------------------------------------------------
-void spawnStaticGlyph(int columnIndex, int glyphIndex, SDL_Rect rect, float initialFade, bool isHead) {
-    if (trailCounts[columnIndex] >= MAX_TRAIL_LENGTH) return;
+// Fade bucket of every glyph of a trail, -1 once faded out. No calls or
+// early exits, so this loop vectorizes.
+SDL_FORCE_INLINE void trail_buckets(const StaticGlyph* trail, int count, float colTravel, int* buckets) {
+    const float bucketScale = fadeLut->scale;
+    const float bucketMax = (float)(FADE_LUT_SIZE - 1);
+    const float fadeDistance = FadeDistance;
+
+    for (int s = 0; s < count; s++) {
+        float distanceSinceSpawn = colTravel - trail[s].fadeTimer;
+        distanceSinceSpawn = distanceSinceSpawn > 0.0f ? distanceSinceSpawn : 0.0f;
+
+        float b = distanceSinceSpawn * bucketScale;
+        b = b < bucketMax ? b : bucketMax;
+        buckets[s] = distanceSinceSpawn < fadeDistance ? (int)b : -1;
+    }
+}
 
-    StaticGlyph* fglyph = &fadingTrails[columnIndex][trailCounts[columnIndex]++];
+// Trail kernel shared by every colour mode. hueShaded is a constant in
+// each specialization below: 0 reads the solid-mode colour table, 1 scales
+// the glyph's own head colour (WAVE/RAINBOW). alpha in [0, 1] is the
+// interpolation fraction between the snapshot's last two steps.
+SDL_FORCE_INLINE void trail_kernel(const RenderSnapshot* snap, float alpha,
+    bool freshSnapshot, const bool hueShaded) {
+    int buckets[MAX_TRAIL_LENGTH];
+
+    for (int c = 0; c < snap->columnCount; c++) {
+        const SnapshotColumn* column = &snap->columns[c];
+        int col = column->col;
+        int count = column->count;
+
+        const StaticGlyph* trail = &snap->glyphs[column->first];
+        int newest = count - 1;
+        float lag = (1.0f - alpha) * column->movement;
+        float colTravel = column->travel - lag;
+
+        trail_buckets(trail, count, colTravel, buckets);
+
+        // Interpolated: the head of a streaming column is drawn every frame
+        // at its gliding position, after the trail. Otherwise it flashes
+        // in place of the newest glyph on the snapshot's first frame.
+        bool glideHead = renderInterpolate && column->active;
+        bool flashHead = !renderInterpolate && freshSnapshot && column->head;
+        int trailCount = flashHead ? newest : count;
+
+        for (int s = 0; s < trailCount; s++) {
+            int bucket = buckets[s];
+            if (bucket < 0) continue;
+
+            const StaticGlyph* SGlyph = &trail[s];
+            SDL_Rect rect = glyph_rect(col, SGlyph);
+            renderStats.glyphs++;
+
+            SDL_Color trailColor = trail_color(SGlyph, bucket, hueShaded);
+
+            SDL_FRect frect = rect_to_frect(&rect);
+            push_glyph_sprite(&frect, SGlyph->glyphIndex, SPRITE_TRAIL, trailColor);
+        }
 
-    fglyph->glyphIndex = glyphIndex;
-    fglyph->fadeTimer = initialFade;
-    fglyph->rect = rect;
-    fglyph->isHead = isHead;
+        int headBucket = buckets[newest];
+        if (headBucket < 0 || (!flashHead && !glideHead)) continue;
 
-    // Per-glyph hue capture:
-    if (headColorMode == 5) {
-        // RAINBOW: random hue per spawned glyph
-        fglyph->spawnHue = (float)(rand() % 360);
-    }
-    else if (headColorMode == 4) {
-        // WAVE: current wave hue per spawned glyph (keeps cycling pattern)
-        fglyph->spawnHue = WaveHue;
-    }
-    else {
-        fglyph->spawnHue = 0.0f;
+        // Flashing and gliding heads both count, as in render_phosphor().
+        const StaticGlyph* newestGlyph = &trail[newest];
+        SDL_Color headColor = hueShaded ? glyph_head_color(newestGlyph) : fadeLut->head;
+        renderStats.glyphs++;
+
+        if (flashHead) {
+            SDL_Rect rect = glyph_rect(col, newestGlyph);
+            SDL_FRect headRect = rect_to_frect(&rect);
+            push_glyph_sprite(&headRect, newestGlyph->glyphIndex, SPRITE_HEAD, headColor);
+        }
+        else {
+            SDL_FRect headRect = {
+                (float)mn[col],
+                column->headY - lag,
+                (float)emptyTextureWidth,
+                (float)emptyTextureHeight
+            };
+            push_glyph_sprite(&headRect, newestGlyph->glyphIndex, SPRITE_HEAD, headColor);
+        }
     }
 }
 
+// The per-mode colours and boosts are already folded into fadeLut, so
+// the only thing left to specialize is where a glyph's colour comes from:
+// the solid modes (GREEN..WHITE) share one kernel, WAVE/RAINBOW the other.
+#define TRAIL_KERNEL_VARIANTS(X) \
+    X(solid, 0)                  \
+    X(hue,   1)
 
-int spawn(void) {
-    if (freeIndexCount <= 0) return -1;
+#define X(name, hueShaded)                                                                  \
+    static void trail_kernel_##name(const RenderSnapshot* snap, float alpha, bool fresh) {  \
+        trail_kernel(snap, alpha, fresh, hueShaded);                                        \
+    }
+TRAIL_KERNEL_VARIANTS(X)
+#undef X
 
-    int randomIndex = -1;
-    int maxTries = 10;
+typedef void (*TrailKernel)(const RenderSnapshot* snap, float alpha, bool freshSnapshot);
 
-    for (int tries = 0; tries < maxTries; ++tries) {
-        int candidate = rand() % RANGE;
-        if (!isActive[candidate]) {
-            randomIndex = candidate;
-            break;
-        }
+// Indexed by hueShaded.
+#define X(name, hueShaded) trail_kernel_##name,
+static const TrailKernel trailKernels[] = { TRAIL_KERNEL_VARIANTS(X) };
+#undef X
+
+SDL_COMPILE_TIME_ASSERT(trail_kernel_count, SDL_arraysize(trailKernels) == 2);
+
+#if defined(SIMD_X86)
+// The same kernels built for AVX2, where the compiler widens the bucket
+// pass to eight lanes.
+#define X(name, hueShaded)                                                                              \
+    TARGET_AVX2 static void trail_kernel_##name##_avx2(const RenderSnapshot* snap, float alpha, bool fresh) { \
+        trail_kernel(snap, alpha, fresh, hueShaded);                                                    \
     }
+TRAIL_KERNEL_VARIANTS(X)
+#undef X
+
+#define X(name, hueShaded) trail_kernel_##name##_avx2,
+static const TrailKernel trailKernelsAvx2[] = { TRAIL_KERNEL_VARIANTS(X) };
+#undef X
+#endif
+
+// Draws one view of the snapshot and touches nothing but render state, so
+// it may run any number of times per snapshot. freshSnapshot: first frame
+// showing this snapshot (flashing heads are due).
+void render_glyph_trails(const RenderSnapshot* snap, float alpha, bool freshSnapshot, int colorMode) {
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_ADD);
+
+    fade_lut_update(colorMode);
+
+    const TrailKernel* kernels = trailKernels;
+#if defined(SIMD_X86)
+    if (simd.level == SIMD_AVX2) kernels = trailKernelsAvx2;
+#endif
+    const bool hueShaded = (colorMode == 4 || colorMode == 5);
+    kernels[hueShaded](snap, alpha, freshSnapshot);
+
+    // Sprite quads go out as one geometry submission per batch.
+    glyph_batch_flush();
+
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+}
 
-    if (randomIndex == -1) {
-        randomIndex = freeIndexList[--freeIndexCount];
+// ---------------------------------------------------------
+// Phosphor pipeline
+// ---------------------------------------------------------
+static bool phosphor_prepare(void) {
+    if (phosphor.target) return true;
+    if (phosphor.unsupported) return false;
+
+    int w = DM.w, h = DM.h;
+    SDL_GetRendererOutputSize(app.renderer, &w, &h);
+
+    if (SDL_RenderTargetSupported(app.renderer))
+        phosphor.target = SDL_CreateTexture(app.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!phosphor.target) {
+        SDL_Log("Phosphor mode unavailable, drawing exact fades: %s", SDL_GetError());
+        phosphor.unsupported = true;
+        return false;
     }
+    SDL_SetTextureBlendMode(phosphor.target, SDL_BLENDMODE_NONE);
+
+    // dst = dst - src, to take the last unit off values the multiply
+    // would round back up to themselves.
+    phosphor.subtract = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_REV_SUBTRACT,
+        SDL_BLENDFACTOR_ZERO, SDL_BLENDFACTOR_ONE, SDL_BLENDOPERATION_ADD);
+    phosphor.canSubtract = SDL_SetRenderDrawBlendMode(app.renderer, phosphor.subtract) == 0;
 
-    headGlyphIndex[randomIndex] = rand() % ALPHABET_SIZE;
+    phosphor.resync = true;
+    return true;
+}
 
-    int spawnX = mn[randomIndex];
+static void phosphor_toggle(void) {
+    phosphor.enabled = !phosphor.enabled;
+    phosphor.resync = true;
+}
 
-    glyph[randomIndex][0].x = spawnX;
-    glyph[randomIndex][0].y = glyph_START_Y;
-    glyph[randomIndex][0].w = emptyTextureWidth;
-    glyph[randomIndex][0].h = emptyTextureHeight;
+// Draws the trails through the accumulation buffer; false if the renderer
+// cannot, in which case the caller draws exact fades.
+static bool render_phosphor(const RenderSnapshot* snap, float alpha, bool freshSnapshot, float frameMs) {
+    if (!phosphor_prepare()) return false;
 
-    float possibleSpeeds[] = { 0.25f, 0.5f, 0.75f };
-    float chosenSpeed;
-    int attempts = 0;
+    fade_lut_update(headColorMode);
 
-    do {
-        chosenSpeed = possibleSpeeds[rand() % 3];
-        attempts++;
-        if (attempts > 10) break;
-    } while (
-        (randomIndex > 0 && isActive[randomIndex - 1] && speed[randomIndex - 1] == chosenSpeed) ||
-        (randomIndex < RANGE - 1 && isActive[randomIndex + 1] && speed[randomIndex + 1] == chosenSpeed)
-        );
+    const bool hueShaded = (headColorMode == 4 || headColorMode == 5);
+    bool resync = phosphor.resync;
+    phosphor.resync = false;
 
-    speed[randomIndex] = chosenSpeed;
-    // Give this column its own evolving speed profile (multiplier around the base speed).
-    SpeedFactor[randomIndex] = frand_range(0.85f, 1.15f);
-    SpeedTarget[randomIndex] = frand_range(SPEED_FACTOR_MIN, SPEED_FACTOR_MAX);
-    SpeedPhase[randomIndex] = frand_range(0.0f, 6.2831853f);
-    SpeedPhaseStep[randomIndex] = frand_range(0.05f, 0.12f);
-    SpeedRetargetTimer[randomIndex] = (float)irand_range(SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
+    SDL_Texture* previous = SDL_GetRenderTarget(app.renderer);
+    SDL_SetRenderTarget(app.renderer, phosphor.target);
 
-    // Fast base speed: shorten initial retarget so the column can brake before it exits.
-    if (speed[randomIndex] >= 2.0f) {
-        SpeedRetargetTimer[randomIndex] = (float)irand_range(6, 16);
+    if (resync) {
+        SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 255);
+        SDL_RenderClear(app.renderer);
+        phosphor.decayMs = 0.0f;
+        phosphor.halvingsOwed = 0.0f;
     }
-    isActive[randomIndex] = 1;
+    else {
+        // Decay once per elapsed simulation step (see PhosphorState).
+        phosphor.decayMs += frameMs;
+        int steps = (int)(phosphor.decayMs / simulationStepMs);
+        if (steps > 0) {
+            phosphor.decayMs -= (float)steps * simulationStepMs;
+            phosphor.halvingsOwed += (float)steps / PHOSPHOR_HALF_LIFE_STEPS;
+            Uint8 k = clamp_u8_float(powf(0.5f, phosphor.halvingsOwed) * 255.0f);
+            phosphor.halvingsOwed = k ? phosphor.halvingsOwed - log2f(255.0f / (float)k) : 0.0f;
+
+            if (k < 255) {
+                SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_MOD);
+                SDL_SetRenderDrawColor(app.renderer, k, k, k, 255);
+                SDL_RenderFillRect(app.renderer, NULL);
+                renderStats.drawCalls++;
+            }
 
-    for (int i = 0; i < freeIndexCount; ++i) {
-        if (freeIndexList[i] == randomIndex) {
-            freeIndexList[i] = freeIndexList[--freeIndexCount];
-            break;
+            if (phosphor.canSubtract) {
+                Uint8 units = (Uint8)(steps < 255 ? steps : 255);
+                SDL_SetRenderDrawBlendMode(app.renderer, phosphor.subtract);
+                SDL_SetRenderDrawColor(app.renderer, units, units, units, 0);
+                SDL_RenderFillRect(app.renderer, NULL);
+                renderStats.drawCalls++;
+            }
         }
     }
 
-    VerticalAccumulator[randomIndex] = 0.0f;
+    // New glyphs only (every live glyph after a resync), at their current fade.
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_ADD);
 
-    return randomIndex;
-}
+    for (int c = 0; c < snap->columnCount; c++) {
+        const SnapshotColumn* column = &snap->columns[c];
+        int col = column->col;
+        const StaticGlyph* trail = &snap->glyphs[column->first];
+        float colTravel = column->travel - (1.0f - alpha) * column->movement;
+
+        // Glyphs with serial >= drawnSerial are new; serials wrap safely.
+        int start = 0;
+        if (!resync) {
+            Uint32 pending = column->headSerial - phosphor.drawnSerial[col];
+            start = pending < (Uint32)column->count ? column->count - (int)pending : 0;
+        }
 
-int move(int i) {
-    if (i < 0 || i >= RANGE) return i;
+        for (int s = start; s < column->count; s++) {
+            const StaticGlyph* SGlyph = &trail[s];
+            int bucket = glyph_fade_bucket(SGlyph, colTravel);
+            if (bucket < 0) continue;
+
+            SDL_Rect rect = glyph_rect(col, SGlyph);
+            SDL_Color trailColor = trail_color(SGlyph, bucket, hueShaded);
+            renderStats.glyphs++;
+
+            SDL_FRect frect = rect_to_frect(&rect);
+            push_glyph_sprite(&frect, SGlyph->glyphIndex, SPRITE_TRAIL, trailColor);
+        }
+
+        phosphor.drawnSerial[col] = column->headSerial;
+    }
+    glyph_batch_flush();
+
+    SDL_SetRenderTarget(app.renderer, previous);
+    SDL_RenderCopy(app.renderer, phosphor.target, NULL, NULL);
+    renderStats.drawCalls++;
+
+    // Heads, on top of the buffer only.
+    for (int c = 0; c < snap->columnCount; c++) {
+        const SnapshotColumn* column = &snap->columns[c];
+        bool glideHead = renderInterpolate && column->active;
+        bool flashHead = !renderInterpolate && freshSnapshot && column->head;
+        if (!glideHead && !flashHead) continue;
+
+        int col = column->col;
+        const StaticGlyph* newestGlyph = &snap->glyphs[column->first + column->count - 1];
+        float lag = (1.0f - alpha) * column->movement;
+
+        int bucket = glyph_fade_bucket(newestGlyph, column->travel - lag);
+        if (bucket < 0) continue;
+
+        SDL_FRect headRect;
+        if (glideHead) {
+            SDL_FRect r = { (float)mn[col], column->headY - lag, (float)emptyTextureWidth, (float)emptyTextureHeight };
+            headRect = r;
+        }
+        else {
+            SDL_Rect rect = glyph_rect(col, newestGlyph);
+            headRect = rect_to_frect(&rect);
+        }
+
+        SDL_Color headColor = hueShaded ? glyph_head_color(newestGlyph) : fadeLut->head;
+        push_glyph_sprite(&headRect, newestGlyph->glyphIndex, SPRITE_HEAD, headColor);
+        renderStats.glyphs++;
+    }
+    glyph_batch_flush();
+
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+// ---------------------------------------------------------
+// CPU compositor
+// ---------------------------------------------------------
+// Exact x / 255, rounded, for x up to 255 * 255.
+static inline Uint32 div255(Uint32 x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline Uint32 add_saturate_u8x4(Uint32 a, Uint32 b) {
+    Uint32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        Uint32 c = ((a >> shift) & 0xFF) + ((b >> shift) & 0xFF);
+        out |= (c > 0xFF ? 0xFF : c) << shift;
+    }
+    return out;
+}
+
+// dst = saturate(dst + coverage * colour / 255) per channel: a sprite
+// under SDL_BLENDMODE_ADD, modulated by the vertex colour.
+static void compose_sprite_span_scalar(Uint32* dst, const Uint8* mask, int n, SDL_Color c) {
+    for (int i = 0; i < n; i++) {
+        Uint32 m = mask[i];
+        if (!m) continue;
+        dst[i] = add_saturate_u8x4(dst[i], (div255(m * c.r) << 16) | (div255(m * c.g) << 8) | div255(m * c.b));
+    }
+}
+
+#if defined(SIMD_X86)
+// Four pixels per iteration: each coverage byte is spread over the four
+// channels, multiplied in 16 bits and divided by 255 as div255() does.
+// The alpha lane of the colour is zero, so destination alpha is kept.
+TARGET_SSE2 static void compose_sprite_span_sse2(Uint32* dst, const Uint8* mask, int n, SDL_Color c) {
+    const __m128i color4 = _mm_set1_epi64x((long long)(((Uint64)c.r << 32) | ((Uint64)c.g << 16) | (Uint64)c.b));
+    const __m128i bias4 = _mm_set1_epi16(128);
+    const __m128i zero4 = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int m4;
+        memcpy(&m4, mask + i, sizeof(m4));
+        if (!m4) continue;
+        __m128i m = _mm_cvtsi32_si128(m4);
+        m = _mm_unpacklo_epi8(m, m);
+        m = _mm_unpacklo_epi16(m, m);
+
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(m, zero4), color4), bias4);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(m, zero4), color4), bias4);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_adds_epu8(d, _mm_packus_epi16(lo, hi)));
+    }
+    compose_sprite_span_scalar(dst + i, mask + i, n - i, c);
+}
+
+TARGET_AVX2 static void compose_sprite_span_avx2(Uint32* dst, const Uint8* mask, int n, SDL_Color c) {
+    const __m256i color8 = _mm256_set1_epi64x((long long)(((Uint64)c.r << 32) | ((Uint64)c.g << 16) | (Uint64)c.b));
+    const __m256i spread8 = _mm256_set1_epi32(0x01010101);
+    const __m256i bias8 = _mm256_set1_epi16(128);
+    const __m256i zero8 = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i m8 = _mm_loadl_epi64((const __m128i*)(mask + i));
+        // Skip empty spans; movemask rather than a 64-bit extract so 32-bit x86 builds.
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(m8, _mm_setzero_si128())) == 0xFFFF) continue;
+        __m256i m = _mm256_mullo_epi32(_mm256_cvtepu8_epi32(m8), spread8);
+
+        __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(m, zero8), color8), bias8);
+        __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(m, zero8), color8), bias8);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8);
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_adds_epu8(d, _mm256_packus_epi16(lo, hi)));
+    }
+    compose_sprite_span_sse2(dst + i, mask + i, n - i, c);
+}
+#endif
+
+#if defined(SIMD_NEON)
+static inline uint8x8_t div255_u16_neon(uint16x8_t x) {
+    x = vaddq_u16(x, vdupq_n_u16(128));
+    return vmovn_u16(vshrq_n_u16(vaddq_u16(x, vshrq_n_u16(x, 8)), 8));
+}
+
+// Eight pixels per iteration, one plane per channel in B, G, R, A byte
+// order (ARGB8888 in memory), added to the deinterleaved destination.
+static void compose_sprite_span_neon(Uint32* dst, const Uint8* mask, int n, SDL_Color c) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t m = vmovl_u8(vld1_u8(mask + i));
+        uint8x8x4_t px = vld4_u8((const uint8_t*)(dst + i));
+        px.val[0] = vqadd_u8(px.val[0], div255_u16_neon(vmulq_n_u16(m, c.b)));
+        px.val[1] = vqadd_u8(px.val[1], div255_u16_neon(vmulq_n_u16(m, c.g)));
+        px.val[2] = vqadd_u8(px.val[2], div255_u16_neon(vmulq_n_u16(m, c.r)));
+        vst4_u8((uint8_t*)(dst + i), px);
+    }
+    compose_sprite_span_scalar(dst + i, mask + i, n - i, c);
+}
+#endif
+
+// Clips a w x h rect at (x, y) to the band [x0, x1) and the framebuffer.
+static inline bool compose_clip(int x0, int x1, int* x, int* y, int* w, int* h, int* skipX, int* skipY) {
+    int cx0 = *x > x0 ? *x : x0;
+    int cy0 = *y > 0 ? *y : 0;
+    int cx1 = *x + *w < x1 ? *x + *w : x1;
+    int cy1 = *y + *h < compositor.height ? *y + *h : compositor.height;
+    if (cx0 >= cx1 || cy0 >= cy1) return false;
+
+    *skipX = cx0 - *x;
+    *skipY = cy0 - *y;
+    *x = cx0; *y = cy0;
+    *w = cx1 - cx0; *h = cy1 - cy0;
+    return true;
+}
+
+// Adds the sprite whose cell is at (x, y), clipped to the band.
+static void compose_sprite(int x0, int x1, int x, int y, int glyphIndex, int kind, SDL_Color color) {
+    int w = sprites.width, h = sprites.height, skipX, skipY;
+    x -= sprites.pad;
+    y -= sprites.pad;
+    if (!compose_clip(x0, x1, &x, &y, &w, &h, &skipX, &skipY)) return;
+
+    const Uint8* mask = sprites.coverage + (size_t)(glyphIndex * SPRITE_KINDS + kind) * (size_t)sprites.width * (size_t)sprites.height;
+    mask += (size_t)skipY * sprites.width + skipX;
+    for (int r = 0; r < h; ++r)
+        simd.spriteSpan(compositor.pixels + (size_t)(y + r) * compositor.pitch + x, mask + (size_t)r * sprites.width, w, color);
+}
+
+// One band: clear, then every trail and head sprite that reaches into it.
+// Saturating adds commute, so the walk order does not matter.
+static void compose_band(int band) {
+    const RenderSnapshot* snap = compositor.snap;
+    const bool hueShaded = compositor.hueShaded;
+    const int cellH = emptyTextureHeight;
+    int buckets[MAX_TRAIL_LENGTH];
+    int glyphs = 0;
+
+    int x0 = band * COMPOSE_BAND_WIDTH;
+    int x1 = x0 + COMPOSE_BAND_WIDTH < compositor.width ? x0 + COMPOSE_BAND_WIDTH : compositor.width;
+
+    for (int y = 0; y < compositor.height; ++y)
+        SDL_memset4(compositor.pixels + (size_t)y * compositor.pitch + x0, 0xFF000000, (size_t)(x1 - x0));
+
+    for (int c = 0; c < snap->columnCount; c++) {
+        const SnapshotColumn* column = &snap->columns[c];
+        int x = mn[column->col];
+        if (x - sprites.pad >= x1 || x - sprites.pad + sprites.width <= x0) continue;
+
+        const StaticGlyph* trail = &snap->glyphs[column->first];
+        int newest = column->count - 1;
+        float lag = (1.0f - compositor.alpha) * column->movement;
+        trail_buckets(trail, column->count, column->travel - lag, buckets);
+
+        bool glideHead = renderInterpolate && column->active;
+        bool flashHead = !renderInterpolate && compositor.freshSnapshot && column->head;
+        int trailCount = flashHead ? newest : column->count;
+        bool counted = x >= x0 && x < x1;
+
+        for (int s = 0; s < trailCount; s++) {
+            int bucket = buckets[s];
+            if (bucket < 0) continue;
+
+            const StaticGlyph* SGlyph = &trail[s];
+            int y = glyph_START_Y + (int)SGlyph->row * cellH;
+            compose_sprite(x0, x1, x, y, SGlyph->glyphIndex, SPRITE_TRAIL, trail_color(SGlyph, bucket, hueShaded));
+            if (counted) glyphs++;
+        }
+
+        int headBucket = buckets[newest];
+        if (headBucket < 0 || (!flashHead && !glideHead)) continue;
+
+        const StaticGlyph* newestGlyph = &trail[newest];
+        SDL_Color headColor = hueShaded ? glyph_head_color(newestGlyph) : fadeLut->head;
+
+        int y = flashHead ? glyph_START_Y + (int)newestGlyph->row * cellH
+                          : (int)floorf(column->headY - lag + 0.5f);
+        if (counted) glyphs++;
+        compose_sprite(x0, x1, x, y, newestGlyph->glyphIndex, SPRITE_HEAD, headColor);
+    }
+
+    SDL_AtomicAdd(&compositor.glyphCount, glyphs);
+}
+
+static void compose_pool_drain(void) {
+    for (;;) {
+        int band = SDL_AtomicAdd(&compositor.cursor, 1);
+        if (band >= compositor.bandCount) break;
+        compose_band(band);
+    }
+}
+
+static int SDLCALL compose_worker_main(void* data) {
+    (void)data;
+    for (;;) {
+        SDL_SemWait(compositor.start);
+        if (SDL_AtomicGet(&compositor.quit)) break;
+
+        compose_pool_drain();
+        SDL_SemPost(compositor.done);
+    }
+    return 0;
+}
+
+// Composites every band of the current job; returns once all are done.
+static void compose_pool_run(void) {
+    SDL_AtomicSet(&compositor.cursor, 0);
+    SDL_AtomicSet(&compositor.glyphCount, 0);
+
+    for (int i = 0; i < compositor.count; ++i)
+        SDL_SemPost(compositor.start);
+
+    compose_pool_drain();
+
+    for (int i = 0; i < compositor.count; ++i)
+        SDL_SemWait(compositor.done);
+}
+
+// Band workers, one per core besides the main thread.
+static void cpu_compositor_init(void) {
+    int workers = SDL_GetCPUCount() - 1;
+    if (workers > COMPOSE_MAX_WORKERS) workers = COMPOSE_MAX_WORKERS;
+    if (workers <= 0) return;
+
+    compositor.start = SDL_CreateSemaphore(0);
+    compositor.done = SDL_CreateSemaphore(0);
+    if (!compositor.start || !compositor.done) {
+        SDL_Log("Compositor workers disabled: %s", SDL_GetError());
+        return;
+    }
+
+    SDL_AtomicSet(&compositor.quit, 0);
+    for (int i = 0; i < workers; ++i) {
+        compositor.threads[i] = SDL_CreateThread(compose_worker_main, "compose-worker", NULL);
+        if (!compositor.threads[i]) {
+            SDL_Log("Could not start compositor worker: %s", SDL_GetError());
+            break;
+        }
+        compositor.count++;
+    }
+}
+
+void cpu_compositor_shutdown(void) {
+    SDL_AtomicSet(&compositor.quit, 1);
+    for (int i = 0; i < compositor.count; ++i)
+        SDL_SemPost(compositor.start);
+    for (int i = 0; i < compositor.count; ++i) {
+        SDL_WaitThread(compositor.threads[i], NULL);
+        compositor.threads[i] = NULL;
+    }
+    compositor.count = 0;
+
+    if (compositor.start) { SDL_DestroySemaphore(compositor.start); compositor.start = NULL; }
+    if (compositor.done) { SDL_DestroySemaphore(compositor.done); compositor.done = NULL; }
+    if (compositor.texture) { SDL_DestroyTexture(compositor.texture); compositor.texture = NULL; }
+}
+
+// Streaming framebuffer at output size, created on first use.
+static bool cpu_compositor_prepare(void) {
+    if (compositor.texture) return true;
+    if (!compositor.enabled) return false;
+
+    int w = DM.w, h = DM.h;
+    SDL_GetRendererOutputSize(app.renderer, &w, &h);
+
+    compositor.texture = SDL_CreateTexture(app.renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, w, h);
+    if (!compositor.texture) {
+        SDL_Log("CPU compositor unavailable, drawing through the renderer: %s", SDL_GetError());
+        compositor.enabled = false;
+        return false;
+    }
+    SDL_SetTextureBlendMode(compositor.texture, SDL_BLENDMODE_NONE);
+
+    compositor.width = w;
+    compositor.height = h;
+    compositor.bandCount = (w + COMPOSE_BAND_WIDTH - 1) / COMPOSE_BAND_WIDTH;
+    return true;
+}
+
+// ---------------------------------------------------------
+// Spawning / movement
+// ---------------------------------------------------------
+void spawnStaticGlyph(int columnIndex, int glyphIndex, int row, float initialFade, RandStream* rs) {
+    if (trailHead[columnIndex] - trailTail[columnIndex] >= MAX_TRAIL_LENGTH) return;
+
+    StaticGlyph* fglyph = &column_trail(columnIndex)[trailHead[columnIndex]++ & TRAIL_MASK];
+
+    fglyph->glyphIndex = (Uint8)glyphIndex;
+    fglyph->fadeTimer = initialFade;
+    fglyph->row = (Uint16)row;
+
+    // Per-glyph head colour, resolved once here instead of every frame.
+    float headR, headG, headB;
+    if (simThread.colorMode == 5) {
+        // RAINBOW: random hue per spawned glyph
+        hueToRGBf((float)rand_below(rs, 360), &headR, &headG, &headB);
+    }
+    else if (simThread.colorMode == 4) {
+        // WAVE: current wave hue per spawned glyph (keeps cycling pattern)
+        hueToRGBf(WaveHue, &headR, &headG, &headB);
+    }
+    else {
+        float baseR, baseG, baseB;
+        color_mode_palette(simThread.colorMode, &baseR, &baseG, &baseB, &headR, &headG, &headB);
+    }
+
+    fglyph->headR = clamp_u8_float(headR);
+    fglyph->headG = clamp_u8_float(headG);
+    fglyph->headB = clamp_u8_float(headB);
+}
+
+
+int spawn(RandStream* pick) {
+    if (freeColumns.count <= 0) return -1;
+
+    // O(1) uniform pick among free columns, removed by swapping with the last.
+    int randomIndex = freeColumns.items[rand_below(pick, freeColumns.count)];
+    column_set_remove(&freeColumns, randomIndex);
+
+    RandStream rs = rand_stream(randomIndex, RAND_SPAWN);
+
+    headGlyphIndex[randomIndex] = rand_below(&rs, ALPHABET_SIZE);
+
+    HeadY[randomIndex] = glyph_START_Y;
+
+    float possibleSpeeds[] = { 0.25f, 0.5f, 0.75f };
+    float chosenSpeed;
+    int attempts = 0;
+
+    do {
+        chosenSpeed = possibleSpeeds[rand_below(&rs, 3)];
+        attempts++;
+        if (attempts > 10) break;
+    } while (
+        (randomIndex > 0 && isActive[randomIndex - 1] && speed[randomIndex - 1] == chosenSpeed) ||
+        (randomIndex < RANGE - 1 && isActive[randomIndex + 1] && speed[randomIndex + 1] == chosenSpeed)
+        );
+
+    speed[randomIndex] = chosenSpeed;
+    // Give this column its own evolving speed profile (multiplier around the base speed).
+    SpeedFactor[randomIndex] = frand_range(&rs, 0.85f, 1.15f);
+    SpeedTarget[randomIndex] = frand_range(&rs, SPEED_FACTOR_MIN, SPEED_FACTOR_MAX);
+    SpeedPhase[randomIndex] = frand_range(&rs, 0.0f, 6.2831853f);
+    SpeedPhaseStep[randomIndex] = frand_range(&rs, 0.05f, 0.12f);
+    SpeedRetargetTimer[randomIndex] = (float)irand_range(&rs, SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
+
+    // Fast base speed: shorten initial retarget so the column can brake before it exits.
+    if (speed[randomIndex] >= 2.0f) {
+        SpeedRetargetTimer[randomIndex] = (float)irand_range(&rs, 6, 16);
+    }
+    isActive[randomIndex] = 1;
+    column_set_add(&liveColumns, randomIndex);
+
+    VerticalAccumulator[randomIndex] = 0.0f;
+
+    return randomIndex;
+}
+
+// Retarget decisions for one column: scalar and branchy (draws from the
+// column's own RAND_RETARGET stream).
+// Runs before the vector kernel so the kernel sees this tick's target.
+static void retarget_speed(int i) {
+    // Dynamic speed: each column eases toward a target multiplier and also gets a subtle wobble + gravity bias.
+    // Burn the retarget timer down faster for fast columns so they change speed before leaving the screen.
+    RandStream rs = rand_stream(i, RAND_RETARGET);
 
-    int   cellH = emptyTextureHeight;
-    // Dynamic speed: each column eases toward a target multiplier and also gets a subtle wobble + gravity bias.
-    // Retarget countdown burns down faster for faster columns so quick columns still change speed before leaving the screen.
-        // Burn the retarget timer down faster for fast columns so they change speed before leaving the screen.
     float burn = SpeedFactor[i] * SPEED_RETARGET_BURN_BOOST;
     if (burn < 0.35f) burn = 0.35f;
     if (burn > 6.0f) burn = 6.0f;
     SpeedRetargetTimer[i] -= burn;
     if (SpeedRetargetTimer[i] <= 0.0f) {
-        SpeedTarget[i] = frand_range(SPEED_FACTOR_MIN, SPEED_FACTOR_MAX);
+        SpeedTarget[i] = frand_range(&rs, SPEED_FACTOR_MIN, SPEED_FACTOR_MAX);
         // Make fast columns visibly dynamic: force strong braking targets when in rocket territory.
         if (SpeedFactor[i] > SPEED_DRAMATIC_BRAKE_THRESHOLD) {
             // High chance: force a slowdown target so the column visibly brakes before it exits.
-            if ((rand() % 100) < SPEED_DRAMATIC_BRAKE_CHANCE) {
-                float uBrake = frand01();
+            if (rand_below(&rs, 100) < SPEED_DRAMATIC_BRAKE_CHANCE) {
+                float uBrake = frand01(&rs);
                 SpeedTarget[i] = SPEED_BRAKE_BAND_MIN + (SPEED_BRAKE_BAND_MAX - SPEED_BRAKE_BAND_MIN) * uBrake;
             }
             else {
@@ -652,25 +1946,46 @@ int move(int i) {
         }
         else if (SpeedFactor[i] > 2.0f) {
             // Moderately fast: still encourage occasional braking.
-            if ((rand() % 100) < 55) {
-                float uBrake = frand01();
+            if (rand_below(&rs, 100) < 55) {
+                float uBrake = frand01(&rs);
                 SpeedTarget[i] = 0.45f + 0.55f * uBrake; // 0.45..1.00
             }
         }
-        SpeedPhaseStep[i] = frand_range(0.05f, 0.12f);
-        SpeedRetargetTimer[i] = (float)irand_range(SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
+        SpeedPhaseStep[i] = frand_range(&rs, 0.05f, 0.12f);
+        SpeedRetargetTimer[i] = (float)irand_range(&rs, SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
     }
     // EARLY-BRAKE POKE: very fast columns can exit before a retarget happens.
     // If we're in rocket territory and not currently aiming slower, occasionally force a braking target NOW.
     if (SpeedFactor[i] > SPEED_DRAMATIC_BRAKE_THRESHOLD && SpeedTarget[i] >= SpeedFactor[i]) {
-        if ((rand() % 100) < SPEED_EARLY_BRAKE_POKE_CHANCE) {
-            float uBrake = frand01();
+        if (rand_below(&rs, 100) < SPEED_EARLY_BRAKE_POKE_CHANCE) {
+            float uBrake = frand01(&rs);
             SpeedTarget[i] = SPEED_BRAKE_BAND_MIN + (SPEED_BRAKE_BAND_MAX - SPEED_BRAKE_BAND_MIN) * uBrake;
             // Ensure we get another retarget soon (keeps the 'alive' feel).
-            SpeedRetargetTimer[i] = (float)irand_range((int)SPEED_EARLY_BRAKE_MIN_COOLDOWN, (int)SPEED_EARLY_BRAKE_MAX_COOLDOWN);
+            SpeedRetargetTimer[i] = (float)irand_range(&rs, (int)SPEED_EARLY_BRAKE_MIN_COOLDOWN, (int)SPEED_EARLY_BRAKE_MAX_COOLDOWN);
         }
     }
+}
 
+// ---------------------------------------------------------
+// Vectorized speed modulation
+// ---------------------------------------------------------
+// Fast sine for the wobble/drift terms: range-reduce to [-pi, pi], then a
+// parabola with one refinement step (max error ~0.001). Scalar and SIMD
+// variants use the same formula so they produce the same motion.
+#define SIN_APPROX_B      1.27323954f    //  4 / pi
+#define SIN_APPROX_C     -0.40528473f    // -4 / pi^2
+#define SIN_APPROX_P      0.225f
+#define TWO_PI_F          6.2831853f
+#define INV_TWO_PI_F      0.15915494f
+
+static inline float sin_approx(float x) {
+    x -= TWO_PI_F * rintf(x * INV_TWO_PI_F);
+    float y = SIN_APPROX_B * x + SIN_APPROX_C * x * fabsf(x);
+    return SIN_APPROX_P * (y * fabsf(y) - y) + y;
+}
+
+// Easing, snap-brake, wobble, drift, gravity and travel for one column.
+static void speed_modulate_scalar(int i) {
     // Smoothly ease current factor toward its target (stronger braking when slowing down).
     float diff = SpeedTarget[i] - SpeedFactor[i];
     float ease = (diff < 0.0f) ? SPEED_EASE_DOWN : SPEED_EASE_UP;
@@ -691,36 +2006,367 @@ int move(int i) {
 
     // Gentle oscillation to avoid all columns feeling mechanically uniform.
     SpeedPhase[i] += SpeedPhaseStep[i];
-    if (SpeedPhase[i] > 6.2831853f) SpeedPhase[i] -= 6.2831853f;
-    float wobble = 1.0f + SPEED_WOBBLE_AMPLITUDE * sinf(SpeedPhase[i]);
-
+    if (SpeedPhase[i] > TWO_PI_F) SpeedPhase[i] -= TWO_PI_F;
+    float wobble = 1.0f + SPEED_WOBBLE_AMPLITUDE * sin_approx(SpeedPhase[i]);
 
     // Continuous drift makes speed feel alive even between retargets (stronger on fast columns).
     float driftAmp = (SpeedFactor[i] > 2.0f) ? SPEED_DRIFT_AMPLITUDE_FAST : SPEED_DRIFT_AMPLITUDE;
-    float drift = 1.0f + driftAmp * sinf(SpeedPhase[i] * 0.77f + 1.3f);
+    float drift = 1.0f + driftAmp * sin_approx(SpeedPhase[i] * 0.77f + 1.3f);
     // Optional gravity-like bias: slightly faster as the head approaches the bottom of the screen.
-    float yNorm = 0.0f;
-    if (DM.h > 0) yNorm = (float)glyph[i][0].y / (float)DM.h;
+    float invH = (DM.h > 0) ? 1.0f / (float)DM.h : 0.0f;
+    float yNorm = (float)HeadY[i] * invH;
     if (yNorm < 0.0f) yNorm = 0.0f; else if (yNorm > 1.0f) yNorm = 1.0f;
     float gravity = 1.0f + SPEED_GRAVITY * yNorm;
 
-    float movement = (float)app.dy * speed[i] * SpeedFactor[i] * wobble * drift * gravity; float prevTravel = ColumnTravel[i];
+    float movement = (float)app.dy * speed[i] * SpeedFactor[i] * wobble * drift * gravity;
+    ColumnMovement[i] = movement;
     ColumnTravel[i] += movement;
+}
+
+#if defined(SIMD_X86)
+TARGET_AVX2 static inline __m256 sin_approx_avx2(__m256 x) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    __m256 k = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(INV_TWO_PI_F)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    x = _mm256_sub_ps(x, _mm256_mul_ps(k, _mm256_set1_ps(TWO_PI_F)));
+    __m256 y = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_APPROX_B), x),
+        _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_APPROX_C), x), _mm256_and_ps(x, absMask)));
+    __m256 yy = _mm256_sub_ps(_mm256_mul_ps(y, _mm256_and_ps(y, absMask)), y);
+    return _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_APPROX_P), yy), y);
+}
+
+// Eight columns per iteration. Column indices come from the live list, so
+// inputs are gathered and results scattered back into the SoA arrays.
+TARGET_AVX2 static int speed_modulate_avx2(const int* cols, int count) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 brake = _mm256_set1_ps(SPEED_DRAMATIC_BRAKE_THRESHOLD);
+    const __m256 invH = _mm256_set1_ps(DM.h > 0 ? 1.0f / (float)DM.h : 0.0f);
+    const __m256 dy = _mm256_set1_ps((float)app.dy);
+
+    int k = 0;
+    for (; k + 8 <= count; k += 8) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)&cols[k]);
+
+        __m256 F = _mm256_i32gather_ps(SpeedFactor, idx, 4);
+        __m256 T = _mm256_i32gather_ps(SpeedTarget, idx, 4);
+        __m256 P = _mm256_i32gather_ps(SpeedPhase, idx, 4);
+        __m256 PS = _mm256_i32gather_ps(SpeedPhaseStep, idx, 4);
+        __m256 S = _mm256_i32gather_ps(speed, idx, 4);
+        __m256 Y = _mm256_cvtepi32_ps(_mm256_i32gather_epi32(HeadY, idx, 4));
+        __m256 TR = _mm256_i32gather_ps(ColumnTravel, idx, 4);
+
+        __m256 diff = _mm256_sub_ps(T, F);
+        __m256 slowing = _mm256_cmp_ps(diff, zero, _CMP_LT_OQ);
+        __m256 ease = _mm256_blendv_ps(_mm256_set1_ps(SPEED_EASE_UP), _mm256_set1_ps(SPEED_EASE_DOWN), slowing);
+        __m256 hardBrake = _mm256_and_ps(slowing, _mm256_cmp_ps(F, two, _CMP_GT_OQ));
+        __m256 boost = _mm256_add_ps(one, _mm256_mul_ps(_mm256_set1_ps(2.75f), _mm256_sub_ps(F, two)));
+        ease = _mm256_blendv_ps(ease, _mm256_mul_ps(ease, boost), hardBrake);
+        F = _mm256_add_ps(F, _mm256_mul_ps(diff, ease));
+
+        __m256 snapOn = _mm256_and_ps(slowing, _mm256_cmp_ps(F, brake, _CMP_GT_OQ));
+        __m256 snap = _mm256_min_ps(_mm256_mul_ps(_mm256_set1_ps(0.22f), _mm256_sub_ps(F, brake)), _mm256_set1_ps(0.35f));
+        F = _mm256_sub_ps(F, _mm256_and_ps(snapOn, snap));
+        F = _mm256_min_ps(_mm256_max_ps(F, _mm256_set1_ps(SPEED_FACTOR_MIN)), _mm256_set1_ps(SPEED_FACTOR_MAX));
+
+        P = _mm256_add_ps(P, PS);
+        P = _mm256_sub_ps(P, _mm256_and_ps(_mm256_cmp_ps(P, _mm256_set1_ps(TWO_PI_F), _CMP_GT_OQ), _mm256_set1_ps(TWO_PI_F)));
+        __m256 wobble = _mm256_add_ps(one, _mm256_mul_ps(_mm256_set1_ps(SPEED_WOBBLE_AMPLITUDE), sin_approx_avx2(P)));
+
+        __m256 driftAmp = _mm256_blendv_ps(_mm256_set1_ps(SPEED_DRIFT_AMPLITUDE), _mm256_set1_ps(SPEED_DRIFT_AMPLITUDE_FAST), _mm256_cmp_ps(F, two, _CMP_GT_OQ));
+        __m256 driftArg = _mm256_add_ps(_mm256_mul_ps(P, _mm256_set1_ps(0.77f)), _mm256_set1_ps(1.3f));
+        __m256 drift = _mm256_add_ps(one, _mm256_mul_ps(driftAmp, sin_approx_avx2(driftArg)));
+
+        __m256 yNorm = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(Y, invH), zero), one);
+        __m256 gravity = _mm256_add_ps(one, _mm256_mul_ps(_mm256_set1_ps(SPEED_GRAVITY), yNorm));
+
+        // Same multiplication order as the scalar path, so results match bit for bit.
+        __m256 movement = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(dy, S), F), wobble), drift), gravity);
+        TR = _mm256_add_ps(TR, movement);
+
+        float f[8], p[8], m[8], t[8];
+        _mm256_storeu_ps(f, F);
+        _mm256_storeu_ps(p, P);
+        _mm256_storeu_ps(m, movement);
+        _mm256_storeu_ps(t, TR);
+        for (int l = 0; l < 8; ++l) {
+            int c = cols[k + l];
+            SpeedFactor[c] = f[l];
+            SpeedPhase[c] = p[l];
+            ColumnMovement[c] = m[l];
+            ColumnTravel[c] = t[l];
+        }
+    }
+    return k;
+}
+
+TARGET_SSE2 static inline __m128 select_ps(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+TARGET_SSE2 static inline __m128 gather_ps(const float* a, const int* c) {
+    return _mm_setr_ps(a[c[0]], a[c[1]], a[c[2]], a[c[3]]);
+}
+
+TARGET_SSE2 static inline void scatter_ps(float* a, const int* c, __m128 v) {
+    float t[4];
+    _mm_storeu_ps(t, v);
+    a[c[0]] = t[0]; a[c[1]] = t[1]; a[c[2]] = t[2]; a[c[3]] = t[3];
+}
+
+TARGET_SSE2 static inline __m128 sin_approx_sse2(__m128 x) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 k = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(INV_TWO_PI_F))));
+    x = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(TWO_PI_F)));
+    __m128 y = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_APPROX_B), x),
+        _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(SIN_APPROX_C), x), _mm_and_ps(x, absMask)));
+    __m128 yy = _mm_sub_ps(_mm_mul_ps(y, _mm_and_ps(y, absMask)), y);
+    return _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_APPROX_P), yy), y);
+}
+
+// Four columns per iteration; same math as speed_modulate_scalar().
+TARGET_SSE2 static int speed_modulate_sse2(const int* cols, int count) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 brake = _mm_set1_ps(SPEED_DRAMATIC_BRAKE_THRESHOLD);
+    const __m128 invH = _mm_set1_ps(DM.h > 0 ? 1.0f / (float)DM.h : 0.0f);
+    const __m128 dy = _mm_set1_ps((float)app.dy);
+
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const int* c = &cols[k];
+
+        __m128 F = gather_ps(SpeedFactor, c);
+        __m128 T = gather_ps(SpeedTarget, c);
+        __m128 P = gather_ps(SpeedPhase, c);
+        __m128 PS = gather_ps(SpeedPhaseStep, c);
+        __m128 S = gather_ps(speed, c);
+        __m128 Y = _mm_setr_ps((float)HeadY[c[0]], (float)HeadY[c[1]], (float)HeadY[c[2]], (float)HeadY[c[3]]);
+        __m128 TR = gather_ps(ColumnTravel, c);
+
+        __m128 diff = _mm_sub_ps(T, F);
+        __m128 slowing = _mm_cmplt_ps(diff, zero);
+        __m128 ease = select_ps(slowing, _mm_set1_ps(SPEED_EASE_DOWN), _mm_set1_ps(SPEED_EASE_UP));
+        __m128 hardBrake = _mm_and_ps(slowing, _mm_cmpgt_ps(F, two));
+        __m128 boost = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(2.75f), _mm_sub_ps(F, two)));
+        ease = select_ps(hardBrake, _mm_mul_ps(ease, boost), ease);
+        F = _mm_add_ps(F, _mm_mul_ps(diff, ease));
+
+        __m128 snapOn = _mm_and_ps(slowing, _mm_cmpgt_ps(F, brake));
+        __m128 snap = _mm_min_ps(_mm_mul_ps(_mm_set1_ps(0.22f), _mm_sub_ps(F, brake)), _mm_set1_ps(0.35f));
+        F = _mm_sub_ps(F, _mm_and_ps(snapOn, snap));
+        F = _mm_min_ps(_mm_max_ps(F, _mm_set1_ps(SPEED_FACTOR_MIN)), _mm_set1_ps(SPEED_FACTOR_MAX));
+
+        P = _mm_add_ps(P, PS);
+        P = _mm_sub_ps(P, _mm_and_ps(_mm_cmpgt_ps(P, _mm_set1_ps(TWO_PI_F)), _mm_set1_ps(TWO_PI_F)));
+        __m128 wobble = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(SPEED_WOBBLE_AMPLITUDE), sin_approx_sse2(P)));
+
+        __m128 driftAmp = select_ps(_mm_cmpgt_ps(F, two), _mm_set1_ps(SPEED_DRIFT_AMPLITUDE_FAST), _mm_set1_ps(SPEED_DRIFT_AMPLITUDE));
+        __m128 driftArg = _mm_add_ps(_mm_mul_ps(P, _mm_set1_ps(0.77f)), _mm_set1_ps(1.3f));
+        __m128 drift = _mm_add_ps(one, _mm_mul_ps(driftAmp, sin_approx_sse2(driftArg)));
+
+        __m128 yNorm = _mm_min_ps(_mm_max_ps(_mm_mul_ps(Y, invH), zero), one);
+        __m128 gravity = _mm_add_ps(one, _mm_mul_ps(_mm_set1_ps(SPEED_GRAVITY), yNorm));
+
+        // Same multiplication order as the scalar path, so results match bit for bit.
+        __m128 movement = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(dy, S), F), wobble), drift), gravity);
+        TR = _mm_add_ps(TR, movement);
+
+        scatter_ps(SpeedFactor, c, F);
+        scatter_ps(SpeedPhase, c, P);
+        scatter_ps(ColumnMovement, c, movement);
+        scatter_ps(ColumnTravel, c, TR);
+    }
+    return k;
+}
+#endif
+
+#if defined(SIMD_NEON)
+static inline uint32x4_t neon_and_u32(uint32x4_t mask, float32x4_t v) {
+    return vandq_u32(mask, vreinterpretq_u32_f32(v));
+}
+
+static inline float32x4_t sin_approx_neon(float32x4_t x) {
+    float32x4_t k = vrndnq_f32(vmulq_f32(x, vdupq_n_f32(INV_TWO_PI_F)));
+    x = vsubq_f32(x, vmulq_f32(k, vdupq_n_f32(TWO_PI_F)));
+    float32x4_t y = vaddq_f32(vmulq_f32(vdupq_n_f32(SIN_APPROX_B), x),
+        vmulq_f32(vmulq_f32(vdupq_n_f32(SIN_APPROX_C), x), vabsq_f32(x)));
+    float32x4_t yy = vsubq_f32(vmulq_f32(y, vabsq_f32(y)), y);
+    return vaddq_f32(vmulq_f32(vdupq_n_f32(SIN_APPROX_P), yy), y);
+}
+
+static inline float32x4_t gather_f32_neon(const float* a, const int* c) {
+    float t[4] = { a[c[0]], a[c[1]], a[c[2]], a[c[3]] };
+    return vld1q_f32(t);
+}
+
+static inline void scatter_f32_neon(float* a, const int* c, float32x4_t v) {
+    float t[4];
+    vst1q_f32(t, v);
+    a[c[0]] = t[0]; a[c[1]] = t[1]; a[c[2]] = t[2]; a[c[3]] = t[3];
+}
+
+// Four columns per iteration; same math as speed_modulate_scalar().
+static int speed_modulate_neon(const int* cols, int count) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t two = vdupq_n_f32(2.0f);
+    const float32x4_t brake = vdupq_n_f32(SPEED_DRAMATIC_BRAKE_THRESHOLD);
+    const float32x4_t invH = vdupq_n_f32(DM.h > 0 ? 1.0f / (float)DM.h : 0.0f);
+    const float32x4_t dy = vdupq_n_f32((float)app.dy);
+
+    int k = 0;
+    for (; k + 4 <= count; k += 4) {
+        const int* c = &cols[k];
+
+        float32x4_t F = gather_f32_neon(SpeedFactor, c);
+        float32x4_t T = gather_f32_neon(SpeedTarget, c);
+        float32x4_t P = gather_f32_neon(SpeedPhase, c);
+        float32x4_t PS = gather_f32_neon(SpeedPhaseStep, c);
+        float32x4_t S = gather_f32_neon(speed, c);
+        float headY[4] = { (float)HeadY[c[0]], (float)HeadY[c[1]], (float)HeadY[c[2]], (float)HeadY[c[3]] };
+        float32x4_t Y = vld1q_f32(headY);
+        float32x4_t TR = gather_f32_neon(ColumnTravel, c);
+
+        float32x4_t diff = vsubq_f32(T, F);
+        uint32x4_t slowing = vcltq_f32(diff, zero);
+        float32x4_t ease = vbslq_f32(slowing, vdupq_n_f32(SPEED_EASE_DOWN), vdupq_n_f32(SPEED_EASE_UP));
+        uint32x4_t hardBrake = vandq_u32(slowing, vcgtq_f32(F, two));
+        float32x4_t boost = vaddq_f32(one, vmulq_f32(vdupq_n_f32(2.75f), vsubq_f32(F, two)));
+        ease = vbslq_f32(hardBrake, vmulq_f32(ease, boost), ease);
+        F = vaddq_f32(F, vmulq_f32(diff, ease));
+
+        uint32x4_t snapOn = vandq_u32(slowing, vcgtq_f32(F, brake));
+        float32x4_t snap = vminq_f32(vmulq_f32(vdupq_n_f32(0.22f), vsubq_f32(F, brake)), vdupq_n_f32(0.35f));
+        F = vsubq_f32(F, vreinterpretq_f32_u32(neon_and_u32(snapOn, snap)));
+        F = vminq_f32(vmaxq_f32(F, vdupq_n_f32(SPEED_FACTOR_MIN)), vdupq_n_f32(SPEED_FACTOR_MAX));
+
+        P = vaddq_f32(P, PS);
+        P = vsubq_f32(P, vreinterpretq_f32_u32(neon_and_u32(vcgtq_f32(P, vdupq_n_f32(TWO_PI_F)), vdupq_n_f32(TWO_PI_F))));
+        float32x4_t wobble = vaddq_f32(one, vmulq_f32(vdupq_n_f32(SPEED_WOBBLE_AMPLITUDE), sin_approx_neon(P)));
+
+        float32x4_t driftAmp = vbslq_f32(vcgtq_f32(F, two), vdupq_n_f32(SPEED_DRIFT_AMPLITUDE_FAST), vdupq_n_f32(SPEED_DRIFT_AMPLITUDE));
+        float32x4_t driftArg = vaddq_f32(vmulq_f32(P, vdupq_n_f32(0.77f)), vdupq_n_f32(1.3f));
+        float32x4_t drift = vaddq_f32(one, vmulq_f32(driftAmp, sin_approx_neon(driftArg)));
+
+        float32x4_t yNorm = vminq_f32(vmaxq_f32(vmulq_f32(Y, invH), zero), one);
+        float32x4_t gravity = vaddq_f32(one, vmulq_f32(vdupq_n_f32(SPEED_GRAVITY), yNorm));
+
+        // Same multiplication order as the scalar path.
+        float32x4_t movement = vmulq_f32(vmulq_f32(vmulq_f32(vmulq_f32(vmulq_f32(dy, S), F), wobble), drift), gravity);
+        TR = vaddq_f32(TR, movement);
+
+        scatter_f32_neon(SpeedFactor, c, F);
+        scatter_f32_neon(SpeedPhase, c, P);
+        scatter_f32_neon(ColumnMovement, c, movement);
+        scatter_f32_neon(ColumnTravel, c, TR);
+    }
+    return k;
+}
+#endif
+
+static int speed_modulate_none(const int* cols, int count) {
+    (void)cols; (void)count;
+    return 0;
+}
+
+// Runs the speed kernel over a list of columns: the selected SIMD variant,
+// scalar for the remainder.
+static void speed_modulate(const int* cols, int count) {
+    int done = simd.speedModulate(cols, count);
+    for (int k = done; k < count; ++k)
+        speed_modulate_scalar(cols[k]);
+}
+
+// ---------------------------------------------------------
+// SIMD dispatch
+// ---------------------------------------------------------
+static bool simd_level_supported(int level) {
+    switch (level) {
+    case SIMD_SCALAR: return true;
+#if defined(SIMD_X86)
+    case SIMD_SSE2:   return SDL_HasSSE2() == SDL_TRUE;
+    case SIMD_AVX2:   return SDL_HasAVX2() == SDL_TRUE;
+#endif
+#if defined(SIMD_NEON)
+    case SIMD_NEON:   return SDL_HasNEON() == SDL_TRUE;
+#endif
+    default:          return false;
+    }
+}
+
+// Picks the widest supported variant (or the --simd one) for every
+// dispatched kernel and logs the choice.
+static void simd_init(void) {
+    int best = SIMD_SCALAR;
+    for (int level = SIMD_SCALAR; level < SIMD_LEVEL_COUNT; ++level)
+        if (simd_level_supported(level)) best = level;
+
+    simd.level = best;
+    if (simd.request >= 0) {
+        if (simd_level_supported(simd.request))
+            simd.level = simd.request;
+        else
+            SDL_Log("SIMD: %s is not available on this CPU", simdLevelNames[simd.request]);
+    }
+
+    simd.speedModulate = speed_modulate_none;
+    simd.spriteSpan = compose_sprite_span_scalar;
+
+    switch (simd.level) {
+#if defined(SIMD_X86)
+    case SIMD_SSE2:
+        simd.speedModulate = speed_modulate_sse2;
+        simd.spriteSpan = compose_sprite_span_sse2;
+        break;
+    case SIMD_AVX2:
+        simd.speedModulate = speed_modulate_avx2;
+        simd.spriteSpan = compose_sprite_span_avx2;
+        break;
+#endif
+#if defined(SIMD_NEON)
+    case SIMD_NEON:
+        simd.speedModulate = speed_modulate_neon;
+        simd.spriteSpan = compose_sprite_span_neon;
+        break;
+#endif
+    default:
+        break;
+    }
+
+    SDL_Log("SIMD kernels: %s (best available: %s)", simdLevelNames[simd.level], simdLevelNames[best]);
+}
+
+// Cell-crossing pass: retires faded glyphs, then spawns a glyph for every
+// cell the head crossed this tick. Uses the movement computed by the kernel.
+int move(int i) {
+    if (i < 0 || i >= RANGE) return i;
+
+    int   cellH = emptyTextureHeight;
+    float movement = ColumnMovement[i];
+    float prevTravel = ColumnTravel[i] - movement;
+
+    // Retire fully faded glyphs from the front of the ring.
+    while (trailTail[i] != trailHead[i] &&
+        ColumnTravel[i] - column_trail(i)[trailTail[i] & TRAIL_MASK].fadeTimer >= FadeDistance) {
+        trailTail[i]++;
+    }
 
     if (!isActive[i]) return i;
 
     VerticalAccumulator[i] += movement;
 
-    int startCount = trailCounts[i];
+    Uint32 startHead = trailHead[i];
     float spawnTravel = prevTravel;
+    RandStream rs = rand_stream(i, RAND_CROSSING);
 
     while (VerticalAccumulator[i] >= cellH) {
         VerticalAccumulator[i] -= cellH;
 
-        SDL_Rect stepRect = glyph[i][0];
-        stepRect.y += cellH;
+        int stepRow = (HeadY[i] - glyph_START_Y) / cellH + 1;
 
-        int newGlyph = rand() % ALPHABET_SIZE;
+        int newGlyph = rand_below(&rs, ALPHABET_SIZE);
         if (headGlyphIndex[i] >= 0 && newGlyph == headGlyphIndex[i])
             newGlyph = (newGlyph + 1) % ALPHABET_SIZE;
 
@@ -729,91 +2375,358 @@ int move(int i) {
         spawnTravel += (float)cellH;
 
         // Spawn as non-head; we mark newest as head after the loop.
-        spawnStaticGlyph(i, headGlyphIndex[i], stepRect, spawnTravel, false);
+        spawnStaticGlyph(i, headGlyphIndex[i], stepRow, spawnTravel, &rs);
 
-        glyph[i][0].y += cellH;
+        HeadY[i] += cellH;
 
-        if (glyph[i][0].y >= DM.h) {
+        if (HeadY[i] >= DM.h) {
+            // Returned to freeColumns by the serial phase of simulate_step().
             isActive[i] = 0;
             headGlyphIndex[i] = -1;
 
-            if (freeIndexCount < RANGE) {
-                freeIndexList[freeIndexCount++] = i;
-            }
-
             VerticalAccumulator[i] = 0.0f;
             SpeedFactor[i] = 1.0f;
             SpeedTarget[i] = 1.0f;
-            SpeedPhase[i] = frand_range(0.0f, 6.2831853f);
-            SpeedPhaseStep[i] = frand_range(0.05f, 0.12f);
-            SpeedRetargetTimer[i] = (float)irand_range(SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
+            SpeedPhase[i] = frand_range(&rs, 0.0f, 6.2831853f);
+            SpeedPhaseStep[i] = frand_range(&rs, 0.05f, 0.12f);
+            SpeedRetargetTimer[i] = (float)irand_range(&rs, SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
             break;
         }
     }
 
-    if (trailCounts[i] > startCount) {
-        fadingTrails[i][trailCounts[i] - 1].isHead = true;
+    if (trailHead[i] != startHead) {
+        headPending[i] = true;
     }
 
     return i;
 }
 
 // ---------------------------------------------------------
-// UI overlay rendering (hotkey-only; slider is visual only)
+// Simulation worker pool
 // ---------------------------------------------------------
-void render_ui_overlay(void) {
-    if (!ui.visible) return;
+// Runs the per-column phases for cols[begin, end). Everything touched here
+// is owned by the column, so chunks may run on any thread in any order.
+static void simulate_columns(const int* cols, int begin, int end) {
+    for (int k = begin; k < end; ++k)
+        retarget_speed(cols[k]);
+
+    speed_modulate(cols + begin, end - begin);
+
+    for (int k = begin; k < end; ++k)
+        move(cols[k]);
+}
+
+static void sim_pool_drain(void) {
+    for (;;) {
+        int begin = SDL_AtomicAdd(&simPool.cursor, SIM_CHUNK_COLUMNS);
+        if (begin >= simPool.colCount) break;
+
+        int end = begin + SIM_CHUNK_COLUMNS;
+        if (end > simPool.colCount) end = simPool.colCount;
+        simulate_columns(simPool.cols, begin, end);
+    }
+}
+
+static int SDLCALL sim_worker_main(void* data) {
+    (void)data;
+    for (;;) {
+        SDL_SemWait(simPool.start);
+        if (SDL_AtomicGet(&simPool.quit)) break;
+
+        sim_pool_drain();
+        SDL_SemPost(simPool.done);
+    }
+    return 0;
+}
+
+static void sim_pool_init(void) {
+    int workers = simThreadsRequested;
+    if (workers < 0) workers = SDL_GetCPUCount() - 2;
+    if (workers > SIM_MAX_WORKERS) workers = SIM_MAX_WORKERS;
+    if (workers <= 0) return;
+
+    simPool.start = SDL_CreateSemaphore(0);
+    simPool.done = SDL_CreateSemaphore(0);
+    if (!simPool.start || !simPool.done) {
+        SDL_Log("Simulation workers disabled: %s", SDL_GetError());
+        sim_pool_shutdown();
+        return;
+    }
+
+    SDL_AtomicSet(&simPool.quit, 0);
+    for (int i = 0; i < workers; ++i) {
+        simPool.threads[i] = SDL_CreateThread(sim_worker_main, "sim-worker", NULL);
+        if (!simPool.threads[i]) {
+            SDL_Log("Could not start simulation worker: %s", SDL_GetError());
+            break;
+        }
+        simPool.count++;
+    }
+}
+
+void sim_pool_shutdown(void) {
+    SDL_AtomicSet(&simPool.quit, 1);
+    for (int i = 0; i < simPool.count; ++i)
+        SDL_SemPost(simPool.start);
+    for (int i = 0; i < simPool.count; ++i) {
+        SDL_WaitThread(simPool.threads[i], NULL);
+        simPool.threads[i] = NULL;
+    }
+    simPool.count = 0;
+
+    if (simPool.start) { SDL_DestroySemaphore(simPool.start); simPool.start = NULL; }
+    if (simPool.done) { SDL_DestroySemaphore(simPool.done); simPool.done = NULL; }
+}
+
+// Per-column phases over the whole live list; returns once every column
+// has been stepped.
+static void sim_pool_run(const int* cols, int count) {
+    if (simPool.count == 0 || count < SIM_PARALLEL_MIN_COLUMNS) {
+        simulate_columns(cols, 0, count);
+        return;
+    }
+
+    simPool.cols = cols;
+    simPool.colCount = count;
+    SDL_AtomicSet(&simPool.cursor, 0);
+
+    for (int i = 0; i < simPool.count; ++i)
+        SDL_SemPost(simPool.start);
+
+    sim_pool_drain();
+
+    for (int i = 0; i < simPool.count; ++i)
+        SDL_SemWait(simPool.done);
+}
+
+// ---------------------------------------------------------
+// Snapshots / simulation thread
+// ---------------------------------------------------------
+// Copies serials [from, to) of one ring into both halves of the mirror.
+static inline void snapshot_copy_glyphs(StaticGlyph* mirror, const StaticGlyph* ring, Uint32 from, Uint32 to) {
+    while (from != to) {
+        int start = (int)(from & TRAIL_MASK);
+        int run = MAX_TRAIL_LENGTH - start;
+        if ((Uint32)run > to - from) run = (int)(to - from);
+
+        memcpy(&mirror[start], &ring[start], (size_t)run * sizeof(StaticGlyph));
+        memcpy(&mirror[start + MAX_TRAIL_LENGTH], &ring[start], (size_t)run * sizeof(StaticGlyph));
+        from += (Uint32)run;
+    }
+}
+
+// Simulation side: brings the back buffer up to date with every non-empty
+// trail, stamps it with the time of the state and swaps it with the ready
+// slot.
+static void snapshot_publish(Uint64 time) {
+    RenderSnapshot* snap = &snapshots[snapshotBack];
+    int columnCount = 0;
+    long long copied = 0;
+
+    for (int col = 0; col < RANGE; ++col) {
+        Uint32 tail = trailTail[col];
+        Uint32 head = trailHead[col];
+        Uint32 count = head - tail;
+        if (count == 0) continue;
+
+        // Serials are per-column and never reused, so everything this buffer
+        // copied in [tail, copiedHead) is still current.
+        Uint32 from = snap->copiedHead[col];
+        if (from - tail > count) from = tail;
+        StaticGlyph* mirror = &snap->glyphs[(size_t)col * 2 * MAX_TRAIL_LENGTH];
+        snapshot_copy_glyphs(mirror, column_trail(col), from, head);
+        snap->copiedHead[col] = head;
+        copied += head - from;
+
+        SnapshotColumn* column = &snap->columns[columnCount++];
+        column->col = col;
+        column->first = col * 2 * MAX_TRAIL_LENGTH + (int)(tail & TRAIL_MASK);
+        column->count = (int)count;
+        column->travel = ColumnTravel[col];
+        column->movement = ColumnMovement[col];
+        column->headY = (float)HeadY[col] + VerticalAccumulator[col];
+        column->headSerial = head;
+        column->head = headPending[col];
+        column->active = isActive[col] != 0;
+
+        headPending[col] = false;
+    }
+
+    snap->columnCount = columnCount;
+    snap->time = time;
+    snap->stepMs = simThread.stepMs;
+    snap->sequence = ++snapshotSequence;
+    simThread.glyphsCopied += copied;
+
+    snapshotBack = SDL_AtomicSet(&snapshotReady, snapshotBack | SNAPSHOT_FRESH) & ~SNAPSHOT_FRESH;
+}
+
+// Render thread: newest published snapshot. The returned buffer stays
+// untouched by the simulation thread until the next acquire.
+static const RenderSnapshot* snapshot_acquire(void) {
+    if (SDL_AtomicGet(&snapshotReady) & SNAPSHOT_FRESH)
+        snapshotFront = SDL_AtomicSet(&snapshotReady, snapshotFront) & ~SNAPSHOT_FRESH;
+    return &snapshots[snapshotFront];
+}
+
+// Interpolation position of a free-running snapshot at `now`: how far the
+// step after it has progressed. Frames trail the simulation by up to one
+// step so heads glide towards the published position.
+static float snapshot_alpha(const RenderSnapshot* snap, Uint64 now) {
+    if (snap->sequence == 0 || now <= snap->time) return 0.0f;
+    double ms = (double)(now - snap->time) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    double alpha = ms / (double)snap->stepMs;
+    return alpha < 1.0 ? (float)alpha : 1.0f;
+}
+
+// Takes the main thread's settings for the next batch of steps.
+static void sim_take_settings(void) {
+    int fps = SDL_AtomicGet(&simThread.fps);
+    simThread.colorMode = SDL_AtomicGet(&simThread.spawnMode);
+    simThread.stepMs = 1000.0f / (float)(fps > 0 ? fps : DEFAULT_SIMULATION_FPS);
+}
+
+// Runs `steps` steps and publishes the state they reach, which belongs to
+// performance counter `time`.
+static void sim_run_steps(int steps, Uint64 time) {
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    for (int i = 0; i < steps; ++i)
+        simulate_step();
+    Uint64 t1 = SDL_GetPerformanceCounter();
+    snapshot_publish(time);
+    Uint64 t2 = SDL_GetPerformanceCounter();
+
+    const double toMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    simThread.busyMs += (double)(t2 - t0) * toMs;
+    simThread.publishMs += (double)(t2 - t1) * toMs;
+    simThread.publishes++;
+}
+
+static int SDLCALL sim_thread_main(void* data) {
+    (void)data;
+    const double toMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+    Uint64 last = SDL_GetPerformanceCounter();
+    double accumulator = 0.0;
+
+    while (!SDL_AtomicGet(&simThread.quit)) {
+        Uint64 now = SDL_GetPerformanceCounter();
+        accumulator += (double)(now - last) * toMs;
+        last = now;
+        if (accumulator > MAX_ACCUMULATOR_MS) {
+            simThread.droppedMs += accumulator - MAX_ACCUMULATOR_MS;
+            accumulator = MAX_ACCUMULATOR_MS;
+        }
+
+        sim_take_settings();
+        int steps = 0;
+        while (accumulator >= simThread.stepMs) {
+            accumulator -= simThread.stepMs;
+            steps++;
+        }
+        // The state reached is due at now - accumulator.
+        if (steps > 0)
+            sim_run_steps(steps, now - (Uint64)(accumulator / toMs));
+
+        double untilNext = simThread.stepMs - accumulator;
+        SDL_SemWaitTimeout(simThread.wake, untilNext > 1.0 ? (Uint32)untilNext : 1);
+    }
+    return 0;
+}
+
+// Main thread: passes the current speed and spawn colour to the
+// simulation, waking it when they changed.
+static void sim_thread_configure(void) {
+    int oldFps = SDL_AtomicSet(&simThread.fps, simulationFPS);
+    int oldMode = SDL_AtomicSet(&simThread.spawnMode, headColorMode);
+    if (simThread.wake && (oldFps != simulationFPS || oldMode != headColorMode))
+        SDL_SemPost(simThread.wake);
+}
+
+// Main thread: steps the simulation inline (no thread, or --bench).
+static void sim_step_inline(int steps, Uint64 time) {
+    sim_thread_configure();
+    sim_take_settings();
+    if (steps > 0) sim_run_steps(steps, time);
+}
 
+// Starts the free-running simulation thread; interactive runs only.
+static void sim_thread_init(void) {
+    sim_thread_configure();
+    sim_take_settings();
+    if (bench.enabled) return;
+
+    simThread.wake = SDL_CreateSemaphore(0);
+    if (simThread.wake) {
+        SDL_AtomicSet(&simThread.quit, 0);
+        simThread.thread = SDL_CreateThread(sim_thread_main, "simulation", NULL);
+    }
+    if (!simThread.thread)
+        SDL_Log("Simulation thread unavailable, stepping inline: %s", SDL_GetError());
+}
+
+void sim_thread_shutdown(void) {
+    if (simThread.thread) {
+        SDL_AtomicSet(&simThread.quit, 1);
+        SDL_SemPost(simThread.wake);
+        SDL_WaitThread(simThread.thread, NULL);
+        simThread.thread = NULL;
+    }
+
+    if (simThread.wake) { SDL_DestroySemaphore(simThread.wake); simThread.wake = NULL; }
+}
+
+// ---------------------------------------------------------
+// UI overlay rendering (hotkey-only; slider is visual only)
+// ---------------------------------------------------------
+// Draws the whole panel with its top-left corner at panel.x, panel.y.
+static void draw_ui_panel(SDL_Rect panel) {
     SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
 
     SDL_SetRenderDrawColor(app.renderer, 38, 38, 46, 220);
-    SDL_RenderFillRect(app.renderer, &ui_panel_rect);
+    SDL_RenderFillRect(app.renderer, &panel);
 
     SDL_SetRenderDrawColor(app.renderer, 90, 90, 100, 255);
-    SDL_RenderDrawRect(app.renderer, &ui_panel_rect);
+    SDL_RenderDrawRect(app.renderer, &panel);
 
     SDL_Color fg = { 255, 255, 255, 255 };
     SDL_Color bg = { 0, 0, 0, 255 };
 
-    SDL_Texture* txtTitle = createTextTexture("MATRIX CODE RAIN CONTROLS", fg, bg);
+    SDL_Texture* txtTitle = text_cache_get("MATRIX CODE RAIN CONTROLS", fg, bg);
     if (txtTitle) {
         int tw, th;
         SDL_QueryTexture(txtTitle, NULL, NULL, &tw, &th);
-        SDL_Rect dst = { ui_panel_rect.x + 16, ui_panel_rect.y + 12, tw, th };
+        SDL_Rect dst = { panel.x + 16, panel.y + 12, tw, th };
         SDL_RenderCopy(app.renderer, txtTitle, NULL, &dst);
-        SDL_DestroyTexture(txtTitle);
     }
 
-    SDL_Texture* txtSpeed = createTextTexture("SIMULATION SPEED", fg, bg);
+    SDL_Texture* txtSpeed = text_cache_get("SIMULATION SPEED", fg, bg);
     if (txtSpeed) {
         int tw, th;
         SDL_QueryTexture(txtSpeed, NULL, NULL, &tw, &th);
         SDL_Rect dst = {
-            ui_panel_rect.x + UI_SLIDER_X,
-            ui_panel_rect.y + UI_SLIDER_Y - 26,
+            panel.x + UI_SLIDER_X,
+            panel.y + UI_SLIDER_Y - 26,
             tw, th
         };
         SDL_RenderCopy(app.renderer, txtSpeed, NULL, &dst);
-        SDL_DestroyTexture(txtSpeed);
     }
 
     char buf[64];
     snprintf(buf, sizeof(buf), "%d", simulationFPS);
-    SDL_Texture* txtValue = createTextTexture(buf, fg, bg);
+    SDL_Texture* txtValue = text_cache_get(buf, fg, bg);
     if (txtValue) {
         int tw, th;
         SDL_QueryTexture(txtValue, NULL, NULL, &tw, &th);
         SDL_Rect dst = {
-            ui_panel_rect.x + UI_SLIDER_X + UI_SLIDER_W + 12,
-            ui_panel_rect.y + UI_SLIDER_Y - th / 2,
+            panel.x + UI_SLIDER_X + UI_SLIDER_W + 12,
+            panel.y + UI_SLIDER_Y - th / 2,
             tw, th
         };
         SDL_RenderCopy(app.renderer, txtValue, NULL, &dst);
-        SDL_DestroyTexture(txtValue);
     }
 
-    int sliderX = ui_panel_rect.x + UI_SLIDER_X;
-    int sliderY = ui_panel_rect.y + UI_SLIDER_Y;
+    int sliderX = panel.x + UI_SLIDER_X;
+    int sliderY = panel.y + UI_SLIDER_Y;
     SDL_Rect track = { sliderX, sliderY, UI_SLIDER_W, UI_SLIDER_H };
 
     SDL_SetRenderDrawColor(app.renderer, 70, 70, 80, 255);
@@ -831,17 +2744,16 @@ void render_ui_overlay(void) {
     SDL_SetRenderDrawColor(app.renderer, 220, 220, 230, 255);
     SDL_RenderFillRect(app.renderer, &knob);
 
-    SDL_Texture* txtColor = createTextTexture("COLOR MODE", fg, bg);
+    SDL_Texture* txtColor = text_cache_get("COLOR MODE", fg, bg);
     if (txtColor) {
         int tw, th;
         SDL_QueryTexture(txtColor, NULL, NULL, &tw, &th);
         SDL_Rect dst = {
-            ui_panel_rect.x + UI_SLIDER_X,
-            ui_panel_rect.y + UI_COLOR_LABEL_Y - 26,
+            panel.x + UI_SLIDER_X,
+            panel.y + UI_COLOR_LABEL_Y - 26,
             tw, th
         };
         SDL_RenderCopy(app.renderer, txtColor, NULL, &dst);
-        SDL_DestroyTexture(txtColor);
     }
 
     const char* modeLabels[6] = {
@@ -862,14 +2774,14 @@ void render_ui_overlay(void) {
         { 255, 255, 255, 255 }
     };
 
-    int labelBaseX = ui_panel_rect.x + UI_COLOR_LABEL_X_OFFSET;
-    int labelBaseY = ui_panel_rect.y + UI_COLOR_LABEL_Y;
+    int labelBaseX = panel.x + UI_COLOR_LABEL_X_OFFSET;
+    int labelBaseY = panel.y + UI_COLOR_LABEL_Y;
 
     for (int c = 0; c < 6; ++c) {
         int rowY = labelBaseY + c * UI_COLOR_ROW_SPACING;
 
         if (c <= 3) {
-            SDL_Texture* tLabel = createTextTexture(modeLabels[c], modeColors[c], bg);
+            SDL_Texture* tLabel = text_cache_get(modeLabels[c], modeColors[c], bg);
             if (!tLabel) continue;
 
             int tw, th;
@@ -885,170 +2797,847 @@ void render_ui_overlay(void) {
                 SDL_RenderDrawRect(app.renderer, &hitRect);
             }
 
-            SDL_RenderCopy(app.renderer, tLabel, NULL, &textRect);
-            SDL_DestroyTexture(tLabel);
+            SDL_RenderCopy(app.renderer, tLabel, NULL, &textRect);
+        }
+        else if (c == 4) {
+            SDL_Color waveColors[4] = {
+                { 255, 0,   0,   255 },
+                { 255, 128, 0,   255 },
+                { 255, 255, 0,   255 },
+                { 0,   255, 0,   255 }
+            };
+
+            SDL_Rect textRect = render_multicolor_text("WAVE", labelBaseX, rowY, waveColors, 4, 0);
+
+            SDL_Rect hitRect = { labelBaseX - 8, rowY - 2, UI_COLOR_HIT_WIDTH, textRect.h + 4 };
+
+            if (c == headColorMode) {
+                SDL_SetRenderDrawColor(app.renderer, 70, 70, 80, 180);
+                SDL_RenderFillRect(app.renderer, &hitRect);
+                SDL_SetRenderDrawColor(app.renderer, 200, 200, 210, 255);
+                SDL_RenderDrawRect(app.renderer, &hitRect);
+            }
+
+            render_multicolor_text("WAVE", labelBaseX, rowY, waveColors, 4, 1);
+        }
+        else if (c == 5) {
+            SDL_Color rainbowColors[7] = {
+                { 255, 0,   0,   255 },
+                { 255, 128, 0,   255 },
+                { 255, 255, 0,   255 },
+                { 0,   255, 0,   255 },
+                { 0,   0,   255, 255 },
+                { 75,  0,   130, 255 },
+                { 148, 0,   211, 255 }
+            };
+
+            SDL_Rect textRect = render_multicolor_text("RAINBOW", labelBaseX, rowY, rainbowColors, 7, 0);
+
+            SDL_Rect hitRect = { labelBaseX - 8, rowY - 2, UI_COLOR_HIT_WIDTH, textRect.h + 4 };
+
+            if (c == headColorMode) {
+                SDL_SetRenderDrawColor(app.renderer, 70, 70, 80, 180);
+                SDL_RenderFillRect(app.renderer, &hitRect);
+                SDL_SetRenderDrawColor(app.renderer, 200, 200, 210, 255);
+                SDL_RenderDrawRect(app.renderer, &hitRect);
+            }
+
+            render_multicolor_text("RAINBOW", labelBaseX, rowY, rainbowColors, 7, 1);
+        }
+    }
+
+    SDL_Texture* txtHint = text_cache_get("PRESS F1 TO TOGGLE UI", fg, bg);
+    if (txtHint) {
+        int tw, th;
+        SDL_QueryTexture(txtHint, NULL, NULL, &tw, &th);
+        SDL_Rect dst = {
+            panel.x + 16,
+            panel.y + panel.h - th - 10,
+            tw, th
+        };
+        SDL_RenderCopy(app.renderer, txtHint, NULL, &dst);
+    }
+
+    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+}
+
+// Retained overlay: the panel is drawn into overlayCache.target only when
+// the values it shows change, then composited with one copy per frame.
+// The target holds premultiplied colour (SDL's BLEND onto a transparent
+// target produces exactly that), so it is composited with ONE,
+// ONE_MINUS_SRC_ALPHA. Renderers without target or custom blend support
+// draw the panel directly every frame.
+static bool ui_overlay_prepare_target(void) {
+    if (overlayCache.target) return true;
+    if (overlayCache.unsupported) return false;
+
+    SDL_BlendMode premultiplied = SDL_ComposeCustomBlendMode(
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+        SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD);
+
+    if (SDL_RenderTargetSupported(app.renderer)) {
+        overlayCache.target = SDL_CreateTexture(app.renderer, SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_TARGET, ui_panel_rect.w, ui_panel_rect.h);
+    }
+    if (overlayCache.target && SDL_SetTextureBlendMode(overlayCache.target, premultiplied) == 0) {
+        overlayCache.valid = false;
+        return true;
+    }
+
+    SDL_Log("UI overlay drawn without a retained target: %s", SDL_GetError());
+    if (overlayCache.target) { SDL_DestroyTexture(overlayCache.target); overlayCache.target = NULL; }
+    overlayCache.unsupported = true;
+    return false;
+}
+
+void render_ui_overlay(void) {
+    if (!ui.visible) return;
+
+    if (!ui_overlay_prepare_target()) {
+        draw_ui_panel(ui_panel_rect);
+        return;
+    }
+
+    if (!overlayCache.valid ||
+        overlayCache.simulationFPS != simulationFPS ||
+        overlayCache.colorMode != headColorMode) {
+        SDL_Texture* previous = SDL_GetRenderTarget(app.renderer);
+        SDL_SetRenderTarget(app.renderer, overlayCache.target);
+
+        SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 0);
+        SDL_RenderClear(app.renderer);
+
+        SDL_Rect panel = { 0, 0, ui_panel_rect.w, ui_panel_rect.h };
+        draw_ui_panel(panel);
+
+        SDL_SetRenderTarget(app.renderer, previous);
+
+        overlayCache.simulationFPS = simulationFPS;
+        overlayCache.colorMode = headColorMode;
+        overlayCache.valid = true;
+    }
+
+    SDL_RenderCopy(app.renderer, overlayCache.target, NULL, &ui_panel_rect);
+}
+
+// ---------------------------------------------------------
+// Initialization
+// ---------------------------------------------------------
+
+// Carves every per-column array out of one zeroed, SIMD-aligned block.
+static void allocate_column_state(void) {
+    size_t stride = ((size_t)RANGE + COLUMN_STRIDE_ALIGN - 1) & ~(size_t)(COLUMN_STRIDE_ALIGN - 1);
+    size_t bytes = stride * COLUMN_ARRAY_COUNT * sizeof(float);
+
+    columnArena = SDL_SIMDAlloc(bytes);
+    if (!columnArena) { SDL_Log("Out of memory: columnArena"); terminate(1); }
+    memset(columnArena, 0, bytes);
+
+    float* slice = (float*)columnArena;
+    speed = slice;               slice += stride;
+    SpeedFactor = slice;         slice += stride;
+    SpeedTarget = slice;         slice += stride;
+    SpeedPhase = slice;          slice += stride;
+    SpeedPhaseStep = slice;      slice += stride;
+    SpeedRetargetTimer = slice;  slice += stride;
+    VerticalAccumulator = slice; slice += stride;
+    ColumnTravel = slice;        slice += stride;
+    ColumnMovement = slice;      slice += stride;
+    mn = (int*)slice;            slice += stride;
+    isActive = (int*)slice;      slice += stride;
+    headGlyphIndex = (int*)slice; slice += stride;
+    HeadY = (int*)slice;         slice += stride;
+}
+
+// Rasterize the alphabet once and pack it into a single coverage sheet.
+// Runs on the sprite loader thread, so failures are returned, not fatal.
+static bool build_glyph_atlas(void) {
+    SDL_Color fg = { 255, 255, 255, 255 };
+    SDL_Color bg = { 0, 0, 0, 255 };
+
+    SDL_Surface* glyphSurfaces[ALPHABET_SIZE] = { 0 };
+
+    // Simple shelf packing: glyphs left to right, new row when the line is full.
+    int penX = ATLAS_PADDING;
+    int penY = ATLAS_PADDING;
+    int rowH = 0;
+
+    for (int i = 0; i < ALPHABET_SIZE; ++i) {
+        glyphSurfaces[i] = TTF_RenderText_Shaded(font1, alphabet[i], fg, bg);
+        if (!glyphSurfaces[i]) {
+            SDL_Log("Failed to render glyph %s: %s", alphabet[i], TTF_GetError());
+            for (int j = 0; j < i; ++j) SDL_FreeSurface(glyphSurfaces[j]);
+            return false;
+        }
+
+        int w = glyphSurfaces[i]->w;
+        int h = glyphSurfaces[i]->h;
+
+        if (penX + w + ATLAS_PADDING > ATLAS_WIDTH) {
+            penX = ATLAS_PADDING;
+            penY += rowH + ATLAS_PADDING;
+            rowH = 0;
+        }
+
+        atlas.src[i].x = penX;
+        atlas.src[i].y = penY;
+        atlas.src[i].w = w;
+        atlas.src[i].h = h;
+
+        penX += w + ATLAS_PADDING;
+        if (h > rowH) rowH = h;
+    }
+
+    atlas.width = ATLAS_WIDTH;
+    atlas.height = penY + rowH + ATLAS_PADDING;
+
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas.width, atlas.height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sheet) {
+        SDL_Log("Failed to create atlas surface: %s", SDL_GetError());
+        for (int i = 0; i < ALPHABET_SIZE; ++i) SDL_FreeSurface(glyphSurfaces[i]);
+        return false;
+    }
+
+    // Same opaque black background the per-glyph textures had.
+    SDL_FillRect(sheet, NULL, SDL_MapRGBA(sheet->format, 0, 0, 0, 255));
+
+    for (int i = 0; i < ALPHABET_SIZE; ++i) {
+        SDL_Rect dst = atlas.src[i];
+        SDL_BlitSurface(glyphSurfaces[i], NULL, sheet, &dst);
+        SDL_FreeSurface(glyphSurfaces[i]);
+    }
+
+    // RGBA32 is byte ordered, so red is the first byte of every pixel.
+    atlas.coverage = (Uint8*)malloc((size_t)atlas.width * (size_t)atlas.height);
+    if (!atlas.coverage) { SDL_Log("Out of memory: atlas.coverage"); SDL_FreeSurface(sheet); return false; }
+    for (int y = 0; y < atlas.height; ++y) {
+        const Uint8* row = (const Uint8*)sheet->pixels + (size_t)y * (size_t)sheet->pitch;
+        for (int x = 0; x < atlas.width; ++x)
+            atlas.coverage[(size_t)y * (size_t)atlas.width + (size_t)x] = row[x * 4];
+    }
+
+    SDL_FreeSurface(sheet);
+    return true;
+}
+
+// Bilinear resample of an 8-bit coverage rect, pixel centres aligned, as
+// a linear-filtered texture is sampled when a glyph is stretched.
+static void resample_coverage(const Uint8* src, int srcPitch, int sw, int sh, Uint8* dst, int dw, int dh) {
+    for (int y = 0; y < dh; ++y) {
+        float fy = ((float)y + 0.5f) * (float)sh / (float)dh - 0.5f;
+        if (fy < 0.0f) fy = 0.0f;
+        int y0 = (int)fy;
+        int y1 = y0 + 1 < sh ? y0 + 1 : sh - 1;
+        float ty = fy - (float)y0;
+
+        for (int x = 0; x < dw; ++x) {
+            float fx = ((float)x + 0.5f) * (float)sw / (float)dw - 0.5f;
+            if (fx < 0.0f) fx = 0.0f;
+            int x0 = (int)fx;
+            int x1 = x0 + 1 < sw ? x0 + 1 : sw - 1;
+            float tx = fx - (float)x0;
+
+            float top = src[y0 * srcPitch + x0] + tx * (float)(src[y0 * srcPitch + x1] - src[y0 * srcPitch + x0]);
+            float bottom = src[y1 * srcPitch + x0] + tx * (float)(src[y1 * srcPitch + x1] - src[y1 * srcPitch + x0]);
+            dst[y * dw + x] = clamp_u8_float(top + ty * (bottom - top) + 0.5f);
+        }
+    }
+}
+
+// In-place separable Gaussian blur of a w x h float image; samples past
+// the edge count as empty.
+static void blur_coverage(float* img, float* tmp, int w, int h, float sigma) {
+    float kernel[2 * 64 + 1];
+    int radius = (int)ceilf(sigma * 2.5f);
+    if (radius > 64) radius = 64;
+
+    float sum = 0.0f;
+    for (int k = -radius; k <= radius; ++k) {
+        kernel[k + radius] = expf(-(float)(k * k) / (2.0f * sigma * sigma));
+        sum += kernel[k + radius];
+    }
+    for (int k = 0; k <= 2 * radius; ++k) kernel[k] /= sum;
+
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float acc = 0.0f;
+            for (int k = -radius; k <= radius; ++k) {
+                int sx = x + k;
+                if (sx >= 0 && sx < w) acc += img[y * w + sx] * kernel[k + radius];
+            }
+            tmp[y * w + x] = acc;
+        }
+    }
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            float acc = 0.0f;
+            for (int k = -radius; k <= radius; ++k) {
+                int sy = y + k;
+                if (sy >= 0 && sy < h) acc += tmp[sy * w + x] * kernel[k + radius];
+            }
+            img[y * w + x] = acc;
+        }
+    }
+}
+
+// Bakes the trail and head sprite of every glyph from the atlas once the
+// cell size is known: the core is the glyph as it used to be drawn, the
+// bloom is the core blurred, and the two are summed so the GPU and the CPU
+// compositor each draw one additive quad per glyph.
+static bool bake_glyph_sprites(void) {
+    const int cellW = emptyTextureWidth, cellH = emptyTextureHeight;
+    const int pad = cellH / 5 > 2 ? cellH / 5 : 2;
+    const int w = cellW + 2 * pad, h = cellH + 2 * pad;
+    const size_t spriteSize = (size_t)w * (size_t)h;
+
+    // Head core: the 110% copy centred on the cell, the normal copy over it.
+    int dw = (int)((float)cellW * 0.1f);
+    int dh = (int)((float)cellH * 0.1f);
+
+    sprites.pad = pad;
+    sprites.width = w;
+    sprites.height = h;
+    sprites.coverage = (Uint8*)malloc(spriteSize * ALPHABET_SIZE * SPRITE_KINDS);
+    if (!sprites.coverage) { SDL_Log("Out of memory: sprites.coverage"); return false; }
+
+    Uint8* cell = (Uint8*)malloc((size_t)cellW * (size_t)cellH);
+    Uint8* big = (Uint8*)malloc((size_t)(cellW + dw) * (size_t)(cellH + dh));
+    float* core = (float*)malloc(spriteSize * sizeof(float));
+    float* bloom = (float*)malloc(spriteSize * sizeof(float));
+    float* tmp = (float*)malloc(spriteSize * sizeof(float));
+    if (!cell || !big || !core || !bloom || !tmp) {
+        SDL_Log("Out of memory: sprite scratch");
+        free(cell); free(big); free(core); free(bloom); free(tmp);
+        return false;
+    }
+
+    for (int i = 0; i < ALPHABET_SIZE; ++i) {
+        const SDL_Rect* r = &atlas.src[i];
+        const Uint8* src = atlas.coverage + (size_t)r->y * (size_t)atlas.width + (size_t)r->x;
+        resample_coverage(src, atlas.width, r->w, r->h, cell, cellW, cellH);
+        resample_coverage(src, atlas.width, r->w, r->h, big, cellW + dw, cellH + dh);
+
+        for (int kind = 0; kind < SPRITE_KINDS; ++kind) {
+            memset(core, 0, spriteSize * sizeof(float));
+            if (kind == SPRITE_HEAD) {
+                int ox = pad - dw / 2, oy = pad - dh / 2;
+                for (int y = 0; y < cellH + dh; ++y)
+                    for (int x = 0; x < cellW + dw; ++x)
+                        core[(oy + y) * w + ox + x] = big[y * (cellW + dw) + x];
+            }
+            for (int y = 0; y < cellH; ++y)
+                for (int x = 0; x < cellW; ++x)
+                    core[(pad + y) * w + pad + x] = cell[y * cellW + x];
+
+            memcpy(bloom, core, spriteSize * sizeof(float));
+            blur_coverage(bloom, tmp, w, h, kind == SPRITE_HEAD ? (float)pad * 0.6f : (float)pad * 0.4f);
+
+            float strength = kind == SPRITE_HEAD ? SPRITE_HALO_STRENGTH : SPRITE_GLOW_STRENGTH;
+            Uint8* out = sprites.coverage + spriteSize * (size_t)(i * SPRITE_KINDS + kind);
+            for (size_t p = 0; p < spriteSize; ++p)
+                out[p] = clamp_u8_float(core[p] + bloom[p] * strength + 0.5f);
+        }
+    }
+    free(cell); free(big); free(core); free(bloom); free(tmp);
+
+    // Only the sprites are drawn from here on.
+    free(atlas.coverage);
+    atlas.coverage = NULL;
+    return true;
+}
+
+static int sprite_sheet_columns(void) {
+    int columns = ATLAS_WIDTH / (sprites.width + ATLAS_PADDING);
+    return columns > 0 ? columns : 1;
+}
+
+// Sprites in rows on one sheet, a black pixel between them so scaled views
+// do not filter in a neighbour. Fills sprites.uv.
+static void sprite_sheet_layout(int* sheetW, int* sheetH) {
+    const int count = ALPHABET_SIZE * SPRITE_KINDS;
+    int columns = sprite_sheet_columns();
+    int rows = (count + columns - 1) / columns;
+    *sheetW = columns * (sprites.width + ATLAS_PADDING) + ATLAS_PADDING;
+    *sheetH = rows * (sprites.height + ATLAS_PADDING) + ATLAS_PADDING;
+
+    for (int n = 0; n < count; ++n) {
+        int sx = ATLAS_PADDING + (n % columns) * (sprites.width + ATLAS_PADDING);
+        int sy = ATLAS_PADDING + (n / columns) * (sprites.height + ATLAS_PADDING);
+        sprites.uv[n].x = (float)sx / (float)*sheetW;
+        sprites.uv[n].y = (float)sy / (float)*sheetH;
+        sprites.uv[n].w = (float)sprites.width / (float)*sheetW;
+        sprites.uv[n].h = (float)sprites.height / (float)*sheetH;
+    }
+}
+
+// Paints sprites.coverage into an RGBA32 sheet laid out as above; NULL
+// if the surface cannot be created.
+static SDL_Surface* build_sprite_sheet(int sheetW, int sheetH) {
+    SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, sheetW, sheetH, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!sheet) {
+        SDL_Log("Failed to create sprite surface: %s", SDL_GetError());
+        return NULL;
+    }
+    SDL_FillRect(sheet, NULL, SDL_MapRGBA(sheet->format, 0, 0, 0, 255));
+
+    const int w = sprites.width, h = sprites.height;
+    const int columns = sprite_sheet_columns();
+    for (int n = 0; n < ALPHABET_SIZE * SPRITE_KINDS; ++n) {
+        int sx = ATLAS_PADDING + (n % columns) * (w + ATLAS_PADDING);
+        int sy = ATLAS_PADDING + (n / columns) * (h + ATLAS_PADDING);
+        const Uint8* in = sprites.coverage + (size_t)w * (size_t)h * (size_t)n;
+        for (int y = 0; y < h; ++y) {
+            Uint8* row = (Uint8*)sheet->pixels + (size_t)(sy + y) * (size_t)sheet->pitch + (size_t)sx * 4;
+            for (int x = 0; x < w; ++x) {
+                Uint8 v = in[y * w + x];
+                row[x * 4 + 0] = v; row[x * 4 + 1] = v; row[x * 4 + 2] = v;
+            }
+        }
+    }
+    return sheet;
+}
+
+// One texture upload for the whole sheet, from a surface or the cache.
+static void upload_sprite_sheet(const void* pixels, int pitch, int sheetW, int sheetH) {
+    sprites.texture = SDL_CreateTexture(app.renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, sheetW, sheetH);
+    if (!sprites.texture || SDL_UpdateTexture(sprites.texture, NULL, pixels, pitch) < 0) {
+        SDL_Log("Failed to create sprite texture: %s", SDL_GetError());
+        terminate(1);
+    }
+
+    // Black is "no light": sprites add onto whatever is below them.
+    SDL_SetTextureBlendMode(sprites.texture, SDL_BLENDMODE_ADD);
+
+#if SDL_VERSION_ATLEAST(2,0,12)
+    // Ensure scaled views use linear filtering (bilinear sampling).
+    SDL_SetTextureScaleMode(sprites.texture, SDL_ScaleModeLinear);
+#endif
+}
+
+// ---------------------------------------------------------
+// Glyph cache
+// ---------------------------------------------------------
+typedef struct {
+    const Uint8* data;
+    size_t       size;
+#if defined(_WIN32)
+    HANDLE       file;
+    HANDLE       mapping;
+#endif
+} MappedFile;
+
+// Maps a whole file read-only. Empty files count as failures.
+static bool map_file(const char* path, MappedFile* mf) {
+    memset(mf, 0, sizeof(*mf));
+#if defined(_WIN32)
+    LARGE_INTEGER size;
+    mf->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (mf->file == INVALID_HANDLE_VALUE) return false;
+    if (!GetFileSizeEx(mf->file, &size) || size.QuadPart <= 0 ||
+        !(mf->mapping = CreateFileMappingA(mf->file, NULL, PAGE_READONLY, 0, 0, NULL))) {
+        CloseHandle(mf->file);
+        return false;
+    }
+    mf->data = (const Uint8*)MapViewOfFile(mf->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!mf->data) {
+        CloseHandle(mf->mapping);
+        CloseHandle(mf->file);
+        return false;
+    }
+    mf->size = (size_t)size.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) { close(fd); return false; }
+
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    mf->data = (const Uint8*)data;
+    mf->size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+static void unmap_file(MappedFile* mf) {
+    if (!mf->data) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(mf->data);
+    CloseHandle(mf->mapping);
+    CloseHandle(mf->file);
+#else
+    munmap((void*)mf->data, mf->size);
+#endif
+    mf->data = NULL;
+}
+
+#define FNV1A_OFFSET  0xcbf29ce484222325ull
+
+static Uint64 fnv1a(Uint64 hash, const void* data, size_t size) {
+    const Uint8* p = (const Uint8*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Cache file path in the pref dir; caller frees. NULL if there is none.
+static char* atlas_cache_path(const char* suffix) {
+    char* dir = SDL_GetPrefPath("Matrix", "MatrixCodeRain");
+    if (!dir) return NULL;
+
+    size_t len = strlen(dir) + strlen(ATLAS_CACHE_FILE) + strlen(suffix) + 1;
+    char* path = (char*)malloc(len);
+    if (path) snprintf(path, len, "%s%s%s", dir, ATLAS_CACHE_FILE, suffix);
+    SDL_free(dir);
+    return path;
+}
+
+// Loads the baked sprites from the cache and leaves it mapped in *file for
+// the sheet upload. On any mismatch or damage the file is ignored (and
+// rewritten after the bake).
+static bool atlas_cache_load(MappedFile* file) {
+    MappedFile font;
+    if (!map_file(FONT_FILE, &font)) return false;
+    atlasCache.fontHash = fnv1a(FNV1A_OFFSET, font.data, font.size);
+    unmap_file(&font);
+
+    atlasCache.alphabetHash = FNV1A_OFFSET;
+    for (int i = 0; i < ALPHABET_SIZE; ++i)
+        atlasCache.alphabetHash = fnv1a(atlasCache.alphabetHash, alphabet[i], strlen(alphabet[i]) + 1);
+
+    if (atlasCache.disabled) return false;
+
+    char* path = atlas_cache_path("");
+    bool mapped = path && map_file(path, file);
+    free(path);
+    if (!mapped) return false;
+
+    AtlasCacheHeader hdr;
+    bool ok = file->size >= sizeof(hdr);
+    if (ok) {
+        memcpy(&hdr, file->data, sizeof(hdr));
+        ok = hdr.magic == ATLAS_CACHE_MAGIC && hdr.version == ATLAS_CACHE_VERSION &&
+            hdr.fontHash == atlasCache.fontHash && hdr.alphabetHash == atlasCache.alphabetHash &&
+            hdr.fontSize == FONT_SIZE && hdr.cellW > 0 && hdr.cellH > 0 && hdr.pad > 0 &&
+            hdr.spriteW == hdr.cellW + 2 * hdr.pad && hdr.spriteH == hdr.cellH + 2 * hdr.pad &&
+            hdr.spriteW <= ATLAS_WIDTH && hdr.spriteH <= ATLAS_WIDTH;
+    }
+
+    size_t sheetSize = 0, coverageSize = 0;
+    if (ok) {
+        sprites.pad = hdr.pad;
+        sprites.width = hdr.spriteW;
+        sprites.height = hdr.spriteH;
+
+        int sheetW, sheetH;
+        sprite_sheet_layout(&sheetW, &sheetH);
+        sheetSize = (size_t)sheetW * (size_t)sheetH * 4;
+        coverageSize = (size_t)hdr.spriteW * (size_t)hdr.spriteH * ALPHABET_SIZE * SPRITE_KINDS;
+        ok = sheetW == hdr.sheetW && sheetH == hdr.sheetH &&
+            file->size == sizeof(hdr) + sheetSize + coverageSize &&
+            fnv1a(FNV1A_OFFSET, file->data + sizeof(hdr), sheetSize + coverageSize) == hdr.payloadHash;
+    }
+
+    if (!ok) {
+        SDL_Log("Glyph cache is stale or damaged, rebuilding it");
+        sprites.pad = sprites.width = sprites.height = 0;
+        unmap_file(file);
+        return false;
+    }
+
+    sprites.coverage = (Uint8*)malloc(coverageSize);
+    if (!sprites.coverage) { SDL_Log("Out of memory: sprites.coverage"); unmap_file(file); return false; }
+    memcpy(sprites.coverage, file->data + sizeof(hdr) + sheetSize, coverageSize);
+
+    emptyTextureWidth = hdr.cellW;
+    emptyTextureHeight = hdr.cellH;
+    return true;
+}
+
+// Writes the freshly baked sprites next to a temporary name first, so a
+// crash mid-write never leaves a cache that passes the size check.
+static void atlas_cache_save(const SDL_Surface* sheet) {
+    if (atlasCache.disabled || !atlasCache.fontHash) return;
+
+    const size_t rowSize = (size_t)sheet->w * 4;
+    const size_t coverageSize = (size_t)sprites.width * (size_t)sprites.height * ALPHABET_SIZE * SPRITE_KINDS;
+
+    AtlasCacheHeader hdr = { 0 };
+    hdr.magic = ATLAS_CACHE_MAGIC;
+    hdr.version = ATLAS_CACHE_VERSION;
+    hdr.fontHash = atlasCache.fontHash;
+    hdr.alphabetHash = atlasCache.alphabetHash;
+    hdr.fontSize = FONT_SIZE;
+    hdr.cellW = emptyTextureWidth;
+    hdr.cellH = emptyTextureHeight;
+    hdr.pad = sprites.pad;
+    hdr.spriteW = sprites.width;
+    hdr.spriteH = sprites.height;
+    hdr.sheetW = sheet->w;
+    hdr.sheetH = sheet->h;
+
+    hdr.payloadHash = FNV1A_OFFSET;
+    for (int y = 0; y < sheet->h; ++y)
+        hdr.payloadHash = fnv1a(hdr.payloadHash, (const Uint8*)sheet->pixels + (size_t)y * (size_t)sheet->pitch, rowSize);
+    hdr.payloadHash = fnv1a(hdr.payloadHash, sprites.coverage, coverageSize);
+
+    char* path = atlas_cache_path("");
+    char* tmpPath = atlas_cache_path(".tmp");
+    SDL_RWops* rw = tmpPath ? SDL_RWFromFile(tmpPath, "wb") : NULL;
+    bool ok = rw && SDL_RWwrite(rw, &hdr, sizeof(hdr), 1) == 1;
+    for (int y = 0; ok && y < sheet->h; ++y)
+        ok = SDL_RWwrite(rw, (const Uint8*)sheet->pixels + (size_t)y * (size_t)sheet->pitch, rowSize, 1) == 1;
+    ok = ok && SDL_RWwrite(rw, sprites.coverage, coverageSize, 1) == 1;
+    if (rw && SDL_RWclose(rw) < 0) ok = false;
+
+    if (ok) {
+        remove(path);
+        ok = rename(tmpPath, path) == 0;
+    }
+    if (!ok) {
+        SDL_Log("Could not write the glyph cache: %s", SDL_GetError());
+        if (tmpPath) remove(tmpPath);
+    }
+    free(path);
+    free(tmpPath);
+}
 
+// Sprites and cell size are produced on a loader thread, from the cache
+// when it matches, otherwise rasterized with SDL_ttf, baked and written
+// back. Only the texture upload waits for the renderer.
+typedef struct {
+    Uint64       start;
+    MappedFile   cache;     // hit: sheet pixels are read from the mapping
+    SDL_Surface* sheet;     // miss: freshly built sheet
+    const void*  pixels;
+    int          pitch;
+    int          sheetW, sheetH;
+    bool         failed;    // reported by sprite_loader_finish() on the main thread
+} SpriteLoader;
+
+SpriteLoader spriteLoader = { 0 };
+
+// Never calls terminate(): the main thread is still building the window
+// and column state, so failures are left in spriteLoader.failed.
+static int SDLCALL sprite_loader_main(void* data) {
+    (void)data;
+
+    atlasCache.hit = atlas_cache_load(&spriteLoader.cache);
+    if (atlasCache.hit) {
+        sprite_sheet_layout(&spriteLoader.sheetW, &spriteLoader.sheetH);
+        spriteLoader.pixels = spriteLoader.cache.data + sizeof(AtlasCacheHeader);
+        spriteLoader.pitch = spriteLoader.sheetW * 4;
+    }
+    else {
+        if (!ui_font() || !build_glyph_atlas()) {
+            spriteLoader.failed = true;
+            return 1;
         }
-        else if (c == 4) {
-            SDL_Color waveColors[4] = {
-                { 255, 0,   0,   255 },
-                { 255, 128, 0,   255 },
-                { 255, 255, 0,   255 },
-                { 0,   255, 0,   255 }
-            };
-
-            SDL_Rect textRect = render_multicolor_text("WAVE", labelBaseX, rowY, waveColors, 4, 0);
 
-            SDL_Rect hitRect = { labelBaseX - 8, rowY - 2, UI_COLOR_HIT_WIDTH, textRect.h + 4 };
+        // Cells are the size of a rendered "0".
+        if (TTF_SizeText(font1, "0", &emptyTextureWidth, &emptyTextureHeight) < 0 || emptyTextureHeight == 0) {
+            SDL_Log("Error: could not measure the glyph cell: %s", TTF_GetError());
+            spriteLoader.failed = true;
+            return 1;
+        }
 
-            if (c == headColorMode) {
-                SDL_SetRenderDrawColor(app.renderer, 70, 70, 80, 180);
-                SDL_RenderFillRect(app.renderer, &hitRect);
-                SDL_SetRenderDrawColor(app.renderer, 200, 200, 210, 255);
-                SDL_RenderDrawRect(app.renderer, &hitRect);
-            }
+        if (!bake_glyph_sprites()) {
+            spriteLoader.failed = true;
+            return 1;
+        }
 
-            render_multicolor_text("WAVE", labelBaseX, rowY, waveColors, 4, 1);
+        sprite_sheet_layout(&spriteLoader.sheetW, &spriteLoader.sheetH);
+        spriteLoader.sheet = build_sprite_sheet(spriteLoader.sheetW, spriteLoader.sheetH);
+        if (!spriteLoader.sheet) {
+            spriteLoader.failed = true;
+            return 1;
         }
-        else if (c == 5) {
-            SDL_Color rainbowColors[7] = {
-                { 255, 0,   0,   255 },
-                { 255, 128, 0,   255 },
-                { 255, 255, 0,   255 },
-                { 0,   255, 0,   255 },
-                { 0,   0,   255, 255 },
-                { 75,  0,   130, 255 },
-                { 148, 0,   211, 255 }
-            };
+        spriteLoader.pixels = spriteLoader.sheet->pixels;
+        spriteLoader.pitch = spriteLoader.sheet->pitch;
+        atlas_cache_save(spriteLoader.sheet);
+    }
 
-            SDL_Rect textRect = render_multicolor_text("RAINBOW", labelBaseX, rowY, rainbowColors, 7, 0);
+    atlasCache.ms = (double)(SDL_GetPerformanceCounter() - spriteLoader.start) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    return 0;
+}
 
-            SDL_Rect hitRect = { labelBaseX - 8, rowY - 2, UI_COLOR_HIT_WIDTH, textRect.h + 4 };
+// Needs TTF_Init(); runs inline if no thread can be started.
+static void sprite_loader_start(void) {
+    spriteLoader.start = SDL_GetPerformanceCounter();
+    startup.spriteThread = SDL_CreateThread(sprite_loader_main, "sprite-loader", NULL);
+    if (!startup.spriteThread) {
+        SDL_Log("Loading glyph sprites inline: %s", SDL_GetError());
+        sprite_loader_main(NULL);
+    }
+}
 
-            if (c == headColorMode) {
-                SDL_SetRenderDrawColor(app.renderer, 70, 70, 80, 180);
-                SDL_RenderFillRect(app.renderer, &hitRect);
-                SDL_SetRenderDrawColor(app.renderer, 200, 200, 210, 255);
-                SDL_RenderDrawRect(app.renderer, &hitRect);
-            }
+// Waits for the loader, then uploads the sheet in one call. Loader
+// failures end the program here, on the main thread.
+static void sprite_loader_finish(void) {
+    Uint64 waitStart = SDL_GetPerformanceCounter();
+    startup_join(&startup.spriteThread);
+    double waitedMs = (double)(SDL_GetPerformanceCounter() - waitStart) * 1000.0 / (double)SDL_GetPerformanceFrequency();
 
-            render_multicolor_text("RAINBOW", labelBaseX, rowY, rainbowColors, 7, 1);
-        }
+    if (spriteLoader.failed) {
+        SDL_Log("Could not prepare the glyph sprites");
+        terminate(1);
     }
 
-    SDL_Texture* txtHint = createTextTexture("PRESS F1 TO TOGGLE UI", fg, bg);
-    if (txtHint) {
-        int tw, th;
-        SDL_QueryTexture(txtHint, NULL, NULL, &tw, &th);
-        SDL_Rect dst = {
-            ui_panel_rect.x + 16,
-            ui_panel_rect.y + ui_panel_rect.h - th - 10,
-            tw, th
-        };
-        SDL_RenderCopy(app.renderer, txtHint, NULL, &dst);
-        SDL_DestroyTexture(txtHint);
-    }
+    upload_sprite_sheet(spriteLoader.pixels, spriteLoader.pitch, spriteLoader.sheetW, spriteLoader.sheetH);
+    unmap_file(&spriteLoader.cache);
+    if (spriteLoader.sheet) { SDL_FreeSurface(spriteLoader.sheet); spriteLoader.sheet = NULL; }
+    spriteLoader.pixels = NULL;
 
-    SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
+    SDL_Log("Glyph sprites: %s in %.1f ms (%.1f ms waited)",
+        atlasCache.hit ? "cache hit" : (atlasCache.disabled ? "cache off" : "cache miss"), atlasCache.ms, waitedMs);
 }
 
 // ---------------------------------------------------------
-// Initialization
+// Audio
 // ---------------------------------------------------------
-void initialize() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) terminate(1);
-    if (TTF_Init() < 0) terminate(1);
-
-    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
+// Device open can block for hundreds of ms on some ALSA/Pulse setups, so
+// the mixer and music come up off the main thread. The audio subsystem
+// itself is initialized by initialize() on the main thread first: SDL2
+// subsystem init is not thread-safe and also brings up events. music is
+// only touched again by terminate(), after the join.
+static int SDLCALL audio_thread_main(void* data) {
+    (void)data;
 
     if (Mix_OpenAudio(48000, MIX_DEFAULT_FORMAT, 2, 4096) < 0) {
         SDL_Log("Mix_OpenAudio failed: %s", Mix_GetError());
+        return 1;
     }
 
-    SDL_GetCurrentDisplayMode(0, &DM);
+    music = Mix_LoadMUS("effects.wav");
+    if (!music) {
+        SDL_Log("Mix_LoadMUS failed: %s", Mix_GetError());
+        return 1;
+    }
+    Mix_PlayMusic(music, -1);
 
-    RANGE = (DM.w + CHAR_SPACING - 1) / CHAR_SPACING;
+    startup.audioMs = startup_elapsed_ms();
+    SDL_Log("Audio playing %.1f ms after start", startup.audioMs);
+    return 0;
+}
+
+void initialize() {
+    if (bench.enabled) {
+        // No display needed: dummy video driver, no audio.
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) terminate(1);
+    }
+    else {
+        if (SDL_Init(SDL_INIT_VIDEO) < 0) terminate(1);
 
-    mn = (int*)malloc(RANGE * sizeof(int));
-    if (!mn) { SDL_Log("Out of memory: mn"); terminate(1); }
+        if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
+            SDL_Log("Audio unavailable, running without sound: %s", SDL_GetError());
+        }
+        else {
+            startup.audioThread = SDL_CreateThread(audio_thread_main, "audio-init", NULL);
+            if (!startup.audioThread) SDL_Log("Could not start audio thread, running without sound: %s", SDL_GetError());
+        }
+    }
+    if (TTF_Init() < 0) terminate(1);
 
-    speed = (float*)malloc(RANGE * sizeof(float));
-    if (!speed) { SDL_Log("Out of memory: speed"); terminate(1); }
+    sprite_loader_start();
+    simd_init();
 
-    // Dynamic speed modulation arrays (per column)
-    SpeedFactor = (float*)malloc(RANGE * sizeof(float));
-    if (!SpeedFactor) { SDL_Log("Out of memory: SpeedFactor"); terminate(1); }
-    SpeedTarget = (float*)malloc(RANGE * sizeof(float));
-    if (!SpeedTarget) { SDL_Log("Out of memory: SpeedTarget"); terminate(1); }
-    SpeedPhase = (float*)malloc(RANGE * sizeof(float));
-    if (!SpeedPhase) { SDL_Log("Out of memory: SpeedPhase"); terminate(1); }
-    SpeedPhaseStep = (float*)malloc(RANGE * sizeof(float));
-    if (!SpeedPhaseStep) { SDL_Log("Out of memory: SpeedPhaseStep"); terminate(1); }
-    SpeedRetargetTimer = (float*)malloc(RANGE * sizeof(float));
-    if (!SpeedRetargetTimer) { SDL_Log("Out of memory: SpeedRetargetTimer"); terminate(1); }
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
 
-    isActive = (int*)malloc(RANGE * sizeof(int));
-    if (!isActive) { SDL_Log("Out of memory: isActive"); terminate(1); }
+    if (!bench.enabled) {
+        SDL_GetCurrentDisplayMode(0, &DM);
+    }
+    else {
+        DM.w = bench.width;
+        DM.h = bench.height;
+    }
 
-    freeIndexList = (int*)malloc(RANGE * sizeof(int));
-    if (!freeIndexList) { SDL_Log("Out of memory: freeIndexList"); terminate(1); }
+    RANGE = (DM.w + CHAR_SPACING - 1) / CHAR_SPACING;
 
-    trailCounts = (int*)calloc((size_t)RANGE, sizeof(int));
-    if (!trailCounts) { SDL_Log("Out of memory: trailCounts"); terminate(1); }
+    allocate_column_state();
 
-    fadingTrails = (StaticGlyph**)malloc(RANGE * sizeof(StaticGlyph*));
-    if (!fadingTrails) { SDL_Log("Out of memory: fadingTrails"); terminate(1); }
+    if (!column_set_init(&freeColumns, RANGE)) { SDL_Log("Out of memory: freeColumns"); terminate(1); }
+    if (!column_set_init(&liveColumns, RANGE)) { SDL_Log("Out of memory: liveColumns"); terminate(1); }
 
-    headGlyphIndex = (int*)malloc(RANGE * sizeof(int));
-    if (!headGlyphIndex) { SDL_Log("Out of memory: headGlyphIndex"); terminate(1); }
+    trailHead = (Uint32*)calloc((size_t)RANGE, sizeof(Uint32));
+    if (!trailHead) { SDL_Log("Out of memory: trailHead"); terminate(1); }
+    trailTail = (Uint32*)calloc((size_t)RANGE, sizeof(Uint32));
+    if (!trailTail) { SDL_Log("Out of memory: trailTail"); terminate(1); }
+    headPending = (bool*)calloc((size_t)RANGE, sizeof(bool));
+    if (!headPending) { SDL_Log("Out of memory: headPending"); terminate(1); }
+    phosphor.drawnSerial = (Uint32*)calloc((size_t)RANGE, sizeof(Uint32));
+    if (!phosphor.drawnSerial) { SDL_Log("Out of memory: phosphor.drawnSerial"); terminate(1); }
 
-    VerticalAccumulator = (float*)calloc((size_t)RANGE, sizeof(float));
-    if (!VerticalAccumulator) { SDL_Log("Out of memory: VerticalAccumulator"); terminate(1); }
+    fadingTrails = (StaticGlyph*)malloc((size_t)RANGE * MAX_TRAIL_LENGTH * sizeof(StaticGlyph));
+    if (!fadingTrails) { SDL_Log("Out of memory: fadingTrails"); terminate(1); }
 
-    ColumnTravel = (float*)calloc((size_t)RANGE, sizeof(float));
-    if (!ColumnTravel) { SDL_Log("Out of memory: ColumnTravel"); terminate(1); }
+    for (int i = 0; i < SNAPSHOT_COUNT; ++i) {
+        snapshots[i].columns = (SnapshotColumn*)malloc((size_t)RANGE * sizeof(SnapshotColumn));
+        if (!snapshots[i].columns) { SDL_Log("Out of memory: snapshot columns"); terminate(1); }
+        snapshots[i].glyphs = (StaticGlyph*)malloc((size_t)RANGE * 2 * MAX_TRAIL_LENGTH * sizeof(StaticGlyph));
+        if (!snapshots[i].glyphs) { SDL_Log("Out of memory: snapshot glyphs"); terminate(1); }
+        snapshots[i].copiedHead = (Uint32*)calloc((size_t)RANGE, sizeof(Uint32));
+        if (!snapshots[i].copiedHead) { SDL_Log("Out of memory: snapshot copiedHead"); terminate(1); }
+        snapshots[i].columnCount = 0;
+    }
 
     for (int i = 0; i < RANGE; ++i) {
         mn[i] = i * CHAR_SPACING;
         speed[i] = 1.0f;
         isActive[i] = 0;
-        freeIndexList[i] = i;
-
-        fadingTrails[i] = (StaticGlyph*)malloc(MAX_TRAIL_LENGTH * sizeof(StaticGlyph));
-        if (!fadingTrails[i]) {
-            SDL_Log("Out of memory: fadingTrails[%d]", i);
-            terminate(1);
-        }
+        column_set_add(&freeColumns, i);
 
         headGlyphIndex[i] = -1;
         ColumnTravel[i] = 0.0f;
         // Initialize dynamic speed state (inactive columns will be reset on spawn too)
         SpeedFactor[i] = 1.0f;
         SpeedTarget[i] = 1.0f;
-        SpeedPhase[i] = frand_range(0.0f, 6.2831853f);
-        SpeedPhaseStep[i] = frand_range(0.05f, 0.12f);
-        SpeedRetargetTimer[i] = (float)irand_range(SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
+        RandStream rs = rand_stream(i, RAND_INIT);
+        SpeedPhase[i] = frand_range(&rs, 0.0f, 6.2831853f);
+        SpeedPhaseStep[i] = frand_range(&rs, 0.05f, 0.12f);
+        SpeedRetargetTimer[i] = (float)irand_range(&rs, SPEED_RETARGET_MIN_FRAMES, SPEED_RETARGET_MAX_FRAMES);
     }
 
-    freeIndexCount = RANGE;
+    if (bench.enabled) {
+        // Software renderer drawing into an offscreen surface; never vsynced.
+        bench.target = SDL_CreateRGBSurfaceWithFormat(0, DM.w, DM.h, 32, SDL_PIXELFORMAT_ARGB8888);
+        if (!bench.target) {
+            SDL_Log("Failed to create benchmark surface: %s", SDL_GetError());
+            terminate(1);
+        }
 
-    app.window = SDL_CreateWindow(
-        "Matrix-Code Rain",
-        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-        DM.w, DM.h,
-        SDL_WINDOW_FULLSCREEN_DESKTOP);
-    if (!app.window) {
-        SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
-        terminate(1);
+        app.renderer = SDL_CreateSoftwareRenderer(bench.target);
+        if (!app.renderer) {
+            SDL_Log("SDL_CreateSoftwareRenderer failed: %s", SDL_GetError());
+            terminate(1);
+        }
     }
+    else {
+        app.window = SDL_CreateWindow(
+            "Matrix-Code Rain",
+            SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+            DM.w, DM.h,
+            SDL_WINDOW_FULLSCREEN_DESKTOP);
+        if (!app.window) {
+            SDL_Log("SDL_CreateWindow failed: %s", SDL_GetError());
+            terminate(1);
+        }
 
-    app.renderer = SDL_CreateRenderer(
-        app.window,
-        -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
-    if (!app.renderer) {
-        SDL_Log("SDL_CreateRenderer failed: %s", SDL_GetError());
-        terminate(1);
+        // --fps-cap paces frames itself; vsync would fight it.
+        Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+        if (frameClock.capFPS <= 0) rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+
+        app.renderer = SDL_CreateRenderer(app.window, -1, rendererFlags);
+        if (!app.renderer) {
+            SDL_Log("SDL_CreateRenderer failed: %s", SDL_GetError());
+            terminate(1);
+        }
     }
 
     // MOUSE ALWAYS HIDDEN
@@ -1056,66 +3645,543 @@ void initialize() {
 
     SDL_SetRenderDrawBlendMode(app.renderer, SDL_BLENDMODE_BLEND);
 
-    font1 = TTF_OpenFont("matrix.ttf", FONT_SIZE);
-    if (!font1) {
-        SDL_Log("TTF_OpenFont failed: %s", TTF_GetError());
-        terminate(1);
+    // --bench keeps measuring the renderer path unless asked otherwise.
+    SDL_RendererInfo rendererInfo;
+    if (compositor.request == COMPOSE_CPU) {
+        compositor.enabled = true;
+    }
+    else if (compositor.request == COMPOSE_AUTO && !bench.enabled &&
+        SDL_GetRendererInfo(app.renderer, &rendererInfo) == 0 && (rendererInfo.flags & SDL_RENDERER_SOFTWARE)) {
+        SDL_Log("Software renderer (%s): compositing trails on the CPU", rendererInfo.name);
+        compositor.enabled = true;
     }
 
-    glyph = (SDL_Rect**)calloc((size_t)RANGE, sizeof(SDL_Rect*));
-    if (!glyph) {
-        SDL_Log("Out of memory: glyph");
-        terminate(1);
+    sprite_loader_finish();
+
+    glyphBatch.vertices = (SDL_Vertex*)malloc((size_t)GLYPH_BATCH_QUADS * 4 * sizeof(SDL_Vertex));
+    if (!glyphBatch.vertices) { SDL_Log("Out of memory: glyphBatch.vertices"); terminate(1); }
+    glyphBatch.indices = (int*)malloc((size_t)GLYPH_BATCH_QUADS * 6 * sizeof(int));
+    if (!glyphBatch.indices) { SDL_Log("Out of memory: glyphBatch.indices"); terminate(1); }
+
+    // Index pattern is fixed: two triangles per quad.
+    for (int q = 0; q < GLYPH_BATCH_QUADS; ++q) {
+        int* idx = &glyphBatch.indices[q * 6];
+        int base = q * 4;
+        idx[0] = base + 0; idx[1] = base + 1; idx[2] = base + 2;
+        idx[3] = base + 0; idx[4] = base + 2; idx[5] = base + 3;
     }
-    for (int i = 0; i < RANGE; ++i) {
-        glyph[i] = (SDL_Rect*)calloc(1, sizeof(SDL_Rect));
-        if (!glyph[i]) {
-            SDL_Log("Out of memory: glyph[%d]", i);
-            terminate(1);
-        }
+    glyphBatch.quadCount = 0;
+
+    if (compositor.enabled) cpu_compositor_init();
+
+    sim_pool_init();
+    sim_thread_init();
+}
+
+// ---------------------------------------------------------
+// Frame clock
+// ---------------------------------------------------------
+static void frame_clock_start(void) {
+    frameClock.frequency = SDL_GetPerformanceFrequency();
+    frameClock.last = SDL_GetPerformanceCounter();
+    frameClock.deadline = frameClock.last;
+}
+
+// Milliseconds since the previous call, clamped to MAX_FRAME_TIME_MS.
+static double frame_clock_tick(void) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    double ms = (double)(now - frameClock.last) * 1000.0 / (double)frameClock.frequency;
+    frameClock.last = now;
+    frameClock.frames++;
+
+    if (ms > frameClock.maxFrameMs) frameClock.maxFrameMs = ms;
+
+    if (ms > MAX_FRAME_TIME_MS) {
+        // The clamp only limits the simulation when it steps inline; the
+        // simulation thread keeps its own clock and cap.
+        if (simThread.thread)
+            SDL_Log("Frame stall: %.1f ms, rendering it as %.0f ms", ms, (double)MAX_FRAME_TIME_MS);
+        else
+            SDL_Log("Frame stall: %.1f ms, simulating only %.0f ms of it", ms, (double)MAX_FRAME_TIME_MS);
+        frameClock.clampedFrames++;
+        frameClock.clampedMs += ms - MAX_FRAME_TIME_MS;
+        ms = MAX_FRAME_TIME_MS;
     }
+    return ms;
+}
 
-    SDL_Color fg = { 255, 255, 255, 255 };
-    SDL_Color bg = { 0, 0, 0, 255 };
+// Caps the accumulator, counting what had to be dropped.
+static double frame_clock_cap_accumulator(double accumulator) {
+    if (accumulator > MAX_ACCUMULATOR_MS) {
+        frameClock.droppedMs += accumulator - MAX_ACCUMULATOR_MS;
+        accumulator = MAX_ACCUMULATOR_MS;
+    }
+    return accumulator;
+}
 
-    for (int i = 0; i < ALPHABET_SIZE; ++i) {
-        gTextures[i].head = createTextTexture(alphabet[i], fg, bg);
-        if (!gTextures[i].head) {
-            SDL_Log("Failed to create glyph texture for %s", alphabet[i]);
-            terminate(1);
-        }
+// With --fps-cap, waits for the next frame deadline; a no-op under vsync.
+static void frame_pacer_wait(void) {
+    if (frameClock.capFPS <= 0) return;
 
-#if SDL_VERSION_ATLEAST(2,0,12)
-        // Ensure scaled glyphs use linear filtering (bilinear sampling).
-        SDL_SetTextureScaleMode(gTextures[i].head, SDL_ScaleModeLinear);
-#endif
+    Uint64 period = frameClock.frequency / (Uint64)frameClock.capFPS;
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    frameClock.deadline += period;
+
+    // More than a period late: start over from now rather than rushing
+    // several frames out back to back.
+    if (now > frameClock.deadline + period) {
+        frameClock.deadline = now;
+        return;
     }
+    if (now >= frameClock.deadline) return;
 
-    SDL_Surface* surf = TTF_RenderText_Shaded(font1, "0", bg, bg);
-    if (!surf) {
-        SDL_Log("Failed to create empty glyph surface: %s", TTF_GetError());
-        terminate(1);
+    double remainingMs = (double)(frameClock.deadline - now) * 1000.0 / (double)frameClock.frequency;
+    if (remainingMs > PACING_SPIN_MS)
+        SDL_Delay((Uint32)(remainingMs - PACING_SPIN_MS));
+
+    while (SDL_GetPerformanceCounter() < frameClock.deadline)
+        SDL_CPUPauseInstruction();
+}
+
+static void frame_clock_report(void) {
+    SDL_Log("Frames: %llu, longest %.1f ms, %llu clamped (%.1f ms cut), %.1f ms of simulation dropped",
+        (unsigned long long)frameClock.frames, frameClock.maxFrameMs,
+        (unsigned long long)frameClock.clampedFrames, frameClock.clampedMs,
+        frameClock.droppedMs);
+}
+
+// ---------------------------------------------------------
+// Simulation step / frame
+// ---------------------------------------------------------
+void simulate_step(void) {
+    RandStream rs = rand_stream(RAND_COLUMN_GLOBAL, RAND_SPAWN);
+    int spawnCount = (rand_below(&rs, 2) == 0) ? 1 : 2;
+    for (int i = 0; i < spawnCount; ++i)
+        spawn(&rs);
+
+    // Per column, possibly across the worker pool: retarget decisions, the
+    // SIMD speed kernel, then the cell-crossing pass.
+    sim_pool_run(liveColumns.items, liveColumns.count);
+
+    // Serial phase: set membership changes in a fixed order, so the result
+    // does not depend on how the columns were split between threads. Walk
+    // backwards so a column removed here (swapped with the last member)
+    // never hides one that has not been visited yet.
+    for (int k = liveColumns.count - 1; k >= 0; --k) {
+        int col = liveColumns.items[k];
+
+        if (!isActive[col] && freeColumns.pos[col] < 0)
+            column_set_add(&freeColumns, col);
+
+        if (!isActive[col] && trailHead[col] == trailTail[col])
+            column_set_remove(&liveColumns, col);
     }
-    emptyTexture = SDL_CreateTextureFromSurface(app.renderer, surf);
-    SDL_FreeSurface(surf);
 
+    advance_wave_hue();
+    simTick++;
+}
 
-#if SDL_VERSION_ATLEAST(2,0,12)
-    // Ensure scaled empty glyphs use linear filtering (bilinear sampling).
-    SDL_SetTextureScaleMode(emptyTexture, SDL_ScaleModeLinear);
-#endif
-    SDL_QueryTexture(emptyTexture, NULL, NULL, &emptyTextureWidth, &emptyTextureHeight);
-    if (emptyTextureHeight == 0) {
-        SDL_Log("Error: emptyTextureHeight is 0");
-        terminate(1);
+// Lays renderViews out as a grid of equal cells over a w x h output. Each
+// view shows the whole simulation scaled to fit its cell, centred.
+static void render_views_layout(int w, int h) {
+    int cols = 1;
+    while (cols * cols < renderViewCount) cols++;
+    int rows = (renderViewCount + cols - 1) / cols;
+
+    float scale = 1.0f / (float)(cols > rows ? cols : rows);
+    int cellW = w / cols, cellH = h / rows;
+    int viewW = (int)((float)w * scale), viewH = (int)((float)h * scale);
+
+    for (int i = 0; i < renderViewCount; ++i) {
+        RenderView* view = &renderViews[i];
+        view->viewport.x = (i % cols) * cellW + (cellW - viewW) / 2;
+        view->viewport.y = (i / cols) * cellH + (cellH - viewH) / 2;
+        view->viewport.w = viewW;
+        view->viewport.h = viewH;
+        view->scale = scale;
     }
+    renderViewsW = w;
+    renderViewsH = h;
+}
 
-    music = Mix_LoadMUS("effects.wav");
-    if (!music) {
-        SDL_Log("Mix_LoadMUS failed: %s", Mix_GetError());
+// View 0 shows headColorMode; the others the solid modes (GREEN..WHITE)
+// in order, skipping headColorMode. At most three are needed.
+static int render_view_color_mode(int view) {
+    if (view == 0) return headColorMode;
+    int mode = view - 1;
+    if (headColorMode <= 3 && mode >= headColorMode) mode++;
+    return mode;
+}
+
+// Every view's trail layer. Views share the snapshot and differ only in
+// viewport, scale and colour mode.
+static void render_views(const RenderSnapshot* snap, float alpha, bool freshSnapshot) {
+    if (renderViewCount == 1) {
+        render_glyph_trails(snap, alpha, freshSnapshot, headColorMode);
+        return;
+    }
+
+    int w = DM.w, h = DM.h;
+    SDL_GetRendererOutputSize(app.renderer, &w, &h);
+    if (w != renderViewsW || h != renderViewsH) render_views_layout(w, h);
+
+    for (int i = 0; i < renderViewCount; ++i) {
+        const RenderView* view = &renderViews[i];
+
+        // The viewport is given in scaled coordinates, so scale goes first.
+        SDL_RenderSetScale(app.renderer, view->scale, view->scale);
+        SDL_Rect viewport = {
+            (int)((float)view->viewport.x / view->scale),
+            (int)((float)view->viewport.y / view->scale),
+            (int)((float)view->viewport.w / view->scale),
+            (int)((float)view->viewport.h / view->scale)
+        };
+        SDL_RenderSetViewport(app.renderer, &viewport);
+
+        render_glyph_trails(snap, alpha, freshSnapshot, render_view_color_mode(i));
+    }
+
+    SDL_RenderSetScale(app.renderer, 1.0f, 1.0f);
+    SDL_RenderSetViewport(app.renderer, NULL);
+}
+
+// The phosphor buffer covers the whole output, so it serves a single view.
+static bool phosphor_active(void) {
+    return phosphor.enabled && renderViewCount == 1;
+}
+
+// The CPU compositor draws a single exact-fade view; it keeps the last
+// frame in its streaming texture and reuses it under the frameCache key.
+static bool cpu_compose_active(void) {
+    return compositor.enabled && renderViewCount == 1 && !phosphor_active();
+}
+
+// Exact-fade trails into frameCache.target when it may be reused: not
+// interpolating (see FrameCache) and not in phosphor mode.
+static bool frame_cache_prepare(void) {
+    if (renderInterpolate || phosphor_active() || cpu_compose_active()) return false;
+    if (frameCache.target) return true;
+    if (frameCache.unsupported) return false;
+
+    int w = DM.w, h = DM.h;
+    SDL_GetRendererOutputSize(app.renderer, &w, &h);
+
+    if (SDL_RenderTargetSupported(app.renderer))
+        frameCache.target = SDL_CreateTexture(app.renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!frameCache.target) {
+        SDL_Log("Frame reuse unavailable: %s", SDL_GetError());
+        frameCache.unsupported = true;
+        return false;
+    }
+    SDL_SetTextureBlendMode(frameCache.target, SDL_BLENDMODE_NONE);
+    frameCache.valid = false;
+    return true;
+}
+
+// Everything the exact-fade trail layer depends on without interpolation.
+static bool frame_cache_matches(const RenderSnapshot* snap, bool freshSnapshot) {
+    return frameCache.valid &&
+        frameCache.sequence == snap->sequence &&
+        frameCache.fresh == freshSnapshot &&
+        frameCache.colorMode == headColorMode &&
+        frameCache.fadeDistance == FadeDistance;
+}
+
+static void frame_cache_store(const RenderSnapshot* snap, bool freshSnapshot) {
+    frameCache.sequence = snap->sequence;
+    frameCache.fresh = freshSnapshot;
+    frameCache.colorMode = headColorMode;
+    frameCache.fadeDistance = FadeDistance;
+    frameCache.valid = true;
+}
+
+// Trail layer through the CPU compositor; false if it could not run, in
+// which case the caller draws through the renderer.
+static bool render_cpu_composed(const RenderSnapshot* snap, float alpha, bool freshSnapshot) {
+    if (!cpu_compositor_prepare()) return false;
+
+    if (!renderInterpolate && frame_cache_matches(snap, freshSnapshot)) {
+        renderStats.framesReused++;
     }
     else {
-        Mix_PlayMusic(music, -1);
+        void* pixels = NULL;
+        int pitch = 0;
+        if (SDL_LockTexture(compositor.texture, NULL, &pixels, &pitch) < 0) {
+            SDL_Log("CPU compositor unavailable, drawing through the renderer: %s", SDL_GetError());
+            compositor.enabled = false;
+            return false;
+        }
+
+        fade_lut_update(headColorMode);
+
+        compositor.snap = snap;
+        compositor.alpha = alpha;
+        compositor.freshSnapshot = freshSnapshot;
+        compositor.hueShaded = (headColorMode == 4 || headColorMode == 5);
+        compositor.pixels = (Uint32*)pixels;
+        compositor.pitch = pitch / (int)sizeof(Uint32);
+        compose_pool_run();
+
+        SDL_UnlockTexture(compositor.texture);
+        renderStats.glyphs += SDL_AtomicGet(&compositor.glyphCount);
+
+        if (renderInterpolate) frameCache.valid = false;
+        else frame_cache_store(snap, freshSnapshot);
+    }
+
+    SDL_RenderCopy(app.renderer, compositor.texture, NULL, NULL);
+    renderStats.drawCalls++;
+    return true;
+}
+
+// frameMs is the time this frame stands for (used by the phosphor decay).
+void render_frame(const RenderSnapshot* snap, float alpha, float frameMs) {
+    // Heads flash on the first frame that shows a snapshot, as they did
+    // when the renderer cleared headPending itself.
+    static Uint32 lastSequence = 0;
+    bool freshSnapshot = snap->sequence != lastSequence;
+    lastSequence = snap->sequence;
+
+    SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 255);
+    SDL_RenderClear(app.renderer);
+
+    if (cpu_compose_active() && render_cpu_composed(snap, alpha, freshSnapshot)) {
+        // Presented from the compositor's framebuffer.
+    }
+    else if (frame_cache_prepare()) {
+        if (frame_cache_matches(snap, freshSnapshot)) {
+            renderStats.framesReused++;
+        }
+        else {
+            SDL_Texture* previous = SDL_GetRenderTarget(app.renderer);
+            SDL_SetRenderTarget(app.renderer, frameCache.target);
+            SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 255);
+            SDL_RenderClear(app.renderer);
+
+            render_views(snap, alpha, freshSnapshot);
+
+            SDL_SetRenderTarget(app.renderer, previous);
+            frame_cache_store(snap, freshSnapshot);
+        }
+        SDL_RenderCopy(app.renderer, frameCache.target, NULL, NULL);
+        renderStats.drawCalls++;
+    }
+    else if (!phosphor_active() || !render_phosphor(snap, alpha, freshSnapshot, frameMs)) {
+        render_views(snap, alpha, freshSnapshot);
+    }
+
+    render_ui_overlay();
+
+    SDL_RenderPresent(app.renderer);
+
+    if (startup.firstFrameMs == 0.0) {
+        startup.firstFrameMs = startup_elapsed_ms();
+        SDL_Log("First frame presented %.1f ms after start", startup.firstFrameMs);
+    }
+}
+
+// ---------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_sorted(const double* v, int n, double p) {
+    if (n <= 0) return 0.0;
+    int idx = (int)(p * (double)(n - 1) + 0.5);
+    if (idx < 0) idx = 0;
+    if (idx >= n) idx = n - 1;
+    return v[idx];
+}
+
+// Runs bench.frames frames at a fixed simulated refresh rate and prints
+// the timings as one JSON object on stdout.
+void run_benchmark(void) {
+    double* frameMs = (double*)malloc((size_t)bench.frames * sizeof(double));
+    if (!frameMs) { SDL_Log("Out of memory: frameMs"); terminate(1); }
+
+    const double toMs = 1000.0 / (double)SDL_GetPerformanceFrequency();
+
+    float accumulator = 0.0f;
+    float jobAlpha = 1.0f;
+    simulationStepMs = 1000.0f / (float)simulationFPS;
+    const float benchFrameMs = 1000.0f / (float)bench.refreshHz;
+
+    double simFrameTotalMs = 0.0;
+    double renderTotalMs = 0.0;
+    long long simSteps = 0;
+    long long glyphsTotal = 0;
+    long long drawCallsTotal = 0;
+    long long framesReused = 0;
+
+    for (int f = 0; f < bench.frames; ++f) {
+        accumulator += benchFrameMs;
+
+        int steps = 0;
+        while (accumulator >= simulationStepMs) {
+            accumulator -= simulationStepMs;
+            steps++;
+        }
+        simSteps += steps;
+
+        // Stepped inline so every run draws the same frames: each frame
+        // shows the snapshot the previous frame's steps published.
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        const RenderSnapshot* snap = snapshot_acquire();
+        float alpha = renderInterpolate ? jobAlpha : 1.0f;
+        sim_step_inline(steps, t0);
+        jobAlpha = accumulator / simulationStepMs;
+        Uint64 t1 = SDL_GetPerformanceCounter();
+
+        renderStats.glyphs = 0;
+        renderStats.drawCalls = 0;
+        renderStats.framesReused = 0;
+        render_frame(snap, alpha, benchFrameMs);
+        Uint64 t2 = SDL_GetPerformanceCounter();
+
+        simFrameTotalMs += (double)(t1 - t0) * toMs;
+        renderTotalMs += (double)(t2 - t1) * toMs;
+        frameMs[f] = (double)(t2 - t0) * toMs;
+        glyphsTotal += renderStats.glyphs;
+        drawCallsTotal += renderStats.drawCalls;
+        framesReused += renderStats.framesReused;
+    }
+
+    double simTotalMs = simThread.busyMs;
+
+    qsort(frameMs, (size_t)bench.frames, sizeof(double), compare_double);
+
+    printf("{\"frames\":%d,\"refresh_hz\":%d,\"seed\":%u,\"width\":%d,\"height\":%d,\"columns\":%d,"
+        "\"simulation_fps\":%d,\"pipeline\":\"%s\",\"compositor\":\"%s\",\"simd\":\"%s\",\"views\":%d,\"color_mode\":%d,\"interpolate\":%s,\"sim_threads\":%d,\"sim_steps\":%lld,"
+        "\"sim_ms_per_step\":%.6f,\"sim_ms_per_frame\":%.6f,\"render_ms_per_frame\":%.6f,"
+        "\"publish_ms\":%.6f,\"publish_glyphs\":%.2f,"
+        "\"glyphs_drawn\":%lld,\"glyphs_per_frame\":%.2f,"
+        "\"draw_calls\":%lld,\"draw_calls_per_frame\":%.2f,\"frames_reused\":%lld,"
+        "\"atlas_cache\":\"%s\",\"atlas_ms\":%.3f,\"first_frame_ms\":%.3f,"
+        "\"frame_ms\":{\"p50\":%.6f,\"p95\":%.6f,\"p99\":%.6f,\"max\":%.6f}}\n",
+        bench.frames, bench.refreshHz, bench.seed, DM.w, DM.h, RANGE,
+        simulationFPS, phosphor_active() ? "phosphor" : "exact", cpu_compose_active() ? "cpu" : "gpu", simdLevelNames[simd.level], renderViewCount, headColorMode, renderInterpolate ? "true" : "false", simPool.count + 1, simSteps,
+        simSteps > 0 ? simTotalMs / (double)simSteps : 0.0,
+        bench.frames > 0 ? simFrameTotalMs / (double)bench.frames : 0.0,
+        bench.frames > 0 ? renderTotalMs / (double)bench.frames : 0.0,
+        simThread.publishes > 0 ? simThread.publishMs / (double)simThread.publishes : 0.0,
+        simThread.publishes > 0 ? (double)simThread.glyphsCopied / (double)simThread.publishes : 0.0,
+        glyphsTotal, bench.frames > 0 ? (double)glyphsTotal / (double)bench.frames : 0.0,
+        drawCallsTotal, bench.frames > 0 ? (double)drawCallsTotal / (double)bench.frames : 0.0, framesReused,
+        atlasCache.hit ? "hit" : (atlasCache.disabled ? "off" : "miss"), atlasCache.ms, startup.firstFrameMs,
+        percentile_sorted(frameMs, bench.frames, 0.50),
+        percentile_sorted(frameMs, bench.frames, 0.95),
+        percentile_sorted(frameMs, bench.frames, 0.99),
+        bench.frames > 0 ? frameMs[bench.frames - 1] : 0.0);
+    fflush(stdout);
+
+    free(frameMs);
+}
+
+// ---------------------------------------------------------
+// Command line
+// ---------------------------------------------------------
+static void print_usage(const char* exe) {
+    printf("usage: %s [--bench [FRAMES]] [--bench-hz HZ] [--seed N] [--size WxH] [--threads N] [--no-interp] [--fps-cap HZ]\n"
+        "       [--color-mode 0-5] [--phosphor] [--views 1-4] [--compose auto|cpu|gpu]\n"
+        "       [--simd scalar|sse2|avx2|neon] [--no-atlas-cache]\n", exe);
+}
+
+// --bench [FRAMES]  headless run on the dummy video driver, JSON report on stdout
+// --bench-hz HZ     simulated display refresh for --bench (default 60)
+// --seed N          fixed random seed (default: time, or BENCH_DEFAULT_SEED with --bench)
+// --size WxH        benchmark resolution (default 1920x1080)
+// --threads N       simulation worker threads (default: cores - 2, 0 = serial)
+// --no-interp       draw simulation steps as published, without interpolation;
+//                   unchanged frames are then re-presented instead of redrawn
+// --fps-cap HZ      pace frames to HZ with a sleep/spin limiter instead of vsync
+// --color-mode N    starting colour mode (0 green .. 3 white, 4 wave, 5 rainbow)
+// --phosphor        start in the phosphor accumulation pipeline (P toggles)
+// --views N         draw the simulation N times in a grid: the colour mode, then
+//                   the solid modes (hue modes cannot be recoloured per view)
+// --compose MODE    trail compositing: gpu (renderer), cpu (SIMD bands into a
+//                   streaming texture), auto (cpu on software renderers)
+// --simd LEVEL      force a kernel variant (default: widest the CPU supports)
+// --no-atlas-cache  always rasterize and bake the glyphs; do not read or write the cache
+static void parse_args(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+
+        if (strcmp(arg, "--bench") == 0) {
+            bench.enabled = 1;
+            if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9') {
+                bench.frames = atoi(argv[++i]);
+                if (bench.frames < 1) bench.frames = 1;
+            }
+        }
+        else if (strcmp(arg, "--bench-hz") == 0 && i + 1 < argc) {
+            int hz = atoi(argv[++i]);
+            if (hz > 0) bench.refreshHz = hz;
+        }
+        else if (strcmp(arg, "--seed") == 0 && i + 1 < argc) {
+            bench.seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+            bench.seedSet = 1;
+        }
+        else if (strcmp(arg, "--size") == 0 && i + 1 < argc) {
+            // WxH; strtol rather than sscanf, which MSVC's SDL checks reject.
+            char* end = NULL;
+            long w = strtol(argv[++i], &end, 10);
+            long h = 0;
+            if (*end == 'x' || *end == 'X') h = strtol(end + 1, &end, 10);
+            if (*end == '\0' && w > 0 && h > 0 && w <= 16384 && h <= 16384) {
+                bench.width = (int)w;
+                bench.height = (int)h;
+            }
+        }
+        else if (strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+            simThreadsRequested = atoi(argv[++i]);
+            if (simThreadsRequested < 0) simThreadsRequested = 0;
+        }
+        else if (strcmp(arg, "--fps-cap") == 0 && i + 1 < argc) {
+            frameClock.capFPS = atoi(argv[++i]);
+            if (frameClock.capFPS < 0) frameClock.capFPS = 0;
+        }
+        else if (strcmp(arg, "--color-mode") == 0 && i + 1 < argc) {
+            int mode = atoi(argv[++i]);
+            if (mode >= 0 && mode <= 5) headColorMode = mode;
+        }
+        else if (strcmp(arg, "--views") == 0 && i + 1 < argc) {
+            int views = atoi(argv[++i]);
+            if (views >= 1 && views <= MAX_RENDER_VIEWS) renderViewCount = views;
+        }
+        else if (strcmp(arg, "--compose") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (strcmp(mode, "cpu") == 0) compositor.request = COMPOSE_CPU;
+            else if (strcmp(mode, "gpu") == 0) compositor.request = COMPOSE_GPU;
+            else compositor.request = COMPOSE_AUTO;
+        }
+        else if (strcmp(arg, "--simd") == 0 && i + 1 < argc) {
+            const char* level = argv[++i];
+            simd.request = -1;
+            for (int l = 0; l < SIMD_LEVEL_COUNT; ++l)
+                if (strcmp(level, simdLevelNames[l]) == 0) simd.request = l;
+            if (simd.request < 0) SDL_Log("Unknown --simd level '%s', using the best available", level);
+        }
+        else if (strcmp(arg, "--phosphor") == 0) {
+            phosphor.enabled = true;
+        }
+        else if (strcmp(arg, "--no-interp") == 0) {
+            renderInterpolate = false;
+        }
+        else if (strcmp(arg, "--no-atlas-cache") == 0) {
+            atlasCache.disabled = true;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) {
+            print_usage(argv[0]);
+            exit(0);
+        }
+        else {
+            SDL_Log("Ignoring unknown argument: %s", arg);
+        }
     }
 }
 
@@ -1123,31 +4189,39 @@ void initialize() {
 // Main loop
 // ---------------------------------------------------------
 int main(int argc, char* argv[]) {
-    (void)argc; (void)argv;
+    startup.start = SDL_GetPerformanceCounter();
+    parse_args(argc, argv);
+
+    if (bench.enabled || bench.seedSet) randSeed = bench.seed;
+    else randSeed = (Uint64)time(NULL);
 
-    srand((unsigned int)time(NULL));
     initialize();
 
-    float accumulator = 0.0f;
+    if (bench.enabled) {
+        run_benchmark();
+        terminate(0);
+    }
+
+    double accumulator = 0.0;   // inline stepping only
     simulationStepMs = 1000.0f / (float)simulationFPS;
 
-    Uint32 previousTime = SDL_GetTicks();
+    frame_clock_start();
 
     while (app.running) {
         // Enforce: mouse always hidden
         SDL_ShowCursor(SDL_DISABLE);
 
-        Uint32 frameStart = SDL_GetTicks();
-        float frameTime = (float)(frameStart - previousTime);
-        previousTime = frameStart;
-
-        if (frameTime > MAX_FRAME_TIME_MS) frameTime = MAX_FRAME_TIME_MS;
-
-        accumulator += frameTime;
-        if (accumulator > MAX_ACCUMULATOR_MS) accumulator = MAX_ACCUMULATOR_MS;
+        double frameMs = frame_clock_tick();
 
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
+            // Target contents are lost with the device; redraw the panel.
+            if (e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+                overlayCache.valid = false;
+                phosphor.resync = true;
+                frameCache.valid = false;
+            }
+
             if (e.type == SDL_QUIT ||
                 (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE))
                 app.running = 0;
@@ -1160,6 +4234,8 @@ int main(int argc, char* argv[]) {
                     SDL_ShowCursor(SDL_DISABLE);
                 }
 
+                if (key == SDLK_p) phosphor_toggle();
+
                 if (ui.visible && key == SDLK_SPACE) {
                     simulationFPS = DEFAULT_SIMULATION_FPS;
                     simulationStepMs = 1000.0f / (float)simulationFPS;
@@ -1189,26 +4265,30 @@ int main(int argc, char* argv[]) {
             }
         }
 
-        while (accumulator >= simulationStepMs) {
-            int spawnCount = (rand() % 2 == 0) ? 1 : 2;
-            for (int i = 0; i < spawnCount; ++i)
-                spawn();
-
-            for (int i = 0; i < RANGE; ++i)
-                move(i);
-
-            accumulator -= simulationStepMs;
+        // The simulation thread steps on its own clock; this frame draws
+        // whatever it published last.
+        sim_thread_configure();
+        if (!simThread.thread) {
+            accumulator = frame_clock_cap_accumulator(accumulator + frameMs);
+            int steps = 0;
+            while (accumulator >= simulationStepMs) {
+                accumulator -= simulationStepMs;
+                steps++;
+            }
+            Uint64 now = SDL_GetPerformanceCounter();
+            sim_step_inline(steps, now - (Uint64)(accumulator * (double)frameClock.frequency / 1000.0));
         }
 
-        SDL_SetRenderDrawColor(app.renderer, 0, 0, 0, 255);
-        SDL_RenderClear(app.renderer);
-
-        render_glyph_trails();
-        render_ui_overlay();
+        const RenderSnapshot* snap = snapshot_acquire();
+        float alpha = renderInterpolate ? snapshot_alpha(snap, SDL_GetPerformanceCounter()) : 1.0f;
 
-        SDL_RenderPresent(app.renderer);
+        render_frame(snap, alpha, (float)frameMs);
+        frame_pacer_wait();
     }
 
+    sim_thread_shutdown();
+    frameClock.droppedMs += simThread.droppedMs;
+    frame_clock_report();
     terminate(0);
     return 0;
 }